@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <iterator_facade/iterator_facade.hpp>
+
+namespace {
+
+namespace iterf = iterator_facade;
+
+/**
+ * @brief Facade over a raw pointer where every hook forwards to the pointer, any difference to the raw pointer
+ * benchmarks is overhead added by the facade operators
+ */
+template <class T, bool Contiguous>
+class pointer_facade : public iterf::iterator_facade<pointer_facade<T, Contiguous>, Contiguous> {
+ public:
+  using value_type = std::remove_cv_t<T>;
+  using difference_type = std::ptrdiff_t;
+
+  constexpr pointer_facade() noexcept = default;
+  constexpr explicit pointer_facade(T* ptr) noexcept : ptr_(ptr) {}
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> T& { return *ptr_; }
+  constexpr void increment() noexcept { ++ptr_; }
+  constexpr void decrement() noexcept { --ptr_; }
+  [[nodiscard]] constexpr auto equals(pointer_facade rhs) const noexcept -> bool { return ptr_ == rhs.ptr_; }
+  [[nodiscard]] constexpr auto distance_to(pointer_facade rhs) const noexcept -> difference_type {
+    return rhs.ptr_ - ptr_;
+  }
+  constexpr void advance(difference_type n) noexcept { ptr_ += n; }
+
+ private:
+  T* ptr_ = nullptr;
+};
+
+struct raw_pointer {
+  template <class T>
+  [[nodiscard]] constexpr static auto wrap(T* ptr) noexcept -> T* {
+    return ptr;
+  }
+};
+
+template <bool Contiguous>
+struct facade {
+  template <class T>
+  [[nodiscard]] constexpr static auto wrap(T* ptr) noexcept -> pointer_facade<T, Contiguous> {
+    return pointer_facade<T, Contiguous>(ptr);
+  }
+};
+
+using random_access_facade = facade<false>;
+using contiguous_facade = facade<true>;
+
+enum class api { std, ranges };
+
+[[nodiscard]] auto make_input(std::int64_t size) -> std::vector<int> {
+  std::mt19937 engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp): reproducible inputs
+  std::uniform_int_distribution<int> distribution(0, 1 << 20);
+
+  std::vector<int> values(static_cast<std::size_t>(size));
+  std::ranges::generate(values, [&] { return distribution(engine); });
+  return values;
+}
+
+// reports throughput as items/s and its inverse as time/element so that runs of different sizes can be compared
+void set_counters(benchmark::State& state, std::int64_t elements) {
+  state.SetItemsProcessed(state.iterations() * elements);
+  state.counters["time/element"] = benchmark::Counter(
+      static_cast<double>(elements), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+template <class Kind>
+void bm_accumulate(benchmark::State& state) {
+  auto const input = make_input(state.range(0));
+  auto const first = Kind::wrap(input.data());
+  auto const last = Kind::wrap(input.data() + input.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::accumulate(first, last, std::int64_t{0}));
+  }
+  set_counters(state, state.range(0));
+}
+
+template <class Kind, api Api>
+void bm_find(benchmark::State& state) {
+  auto const input = make_input(state.range(0));
+  auto const first = Kind::wrap(input.data());
+  auto const last = Kind::wrap(input.data() + input.size());
+
+  for (auto _ : state) {
+    // value is never present so the whole range is scanned
+    if constexpr (Api == api::std) {
+      benchmark::DoNotOptimize(std::find(first, last, -1));
+    } else {
+      benchmark::DoNotOptimize(std::ranges::find(first, last, -1));
+    }
+  }
+  set_counters(state, state.range(0));
+}
+
+template <class Kind, api Api>
+void bm_copy(benchmark::State& state) {
+  auto const input = make_input(state.range(0));
+  std::vector<int> output(input.size());
+  auto const first = Kind::wrap(input.data());
+  auto const last = Kind::wrap(input.data() + input.size());
+  auto const out = Kind::wrap(output.data());
+
+  for (auto _ : state) {
+    if constexpr (Api == api::std) {
+      benchmark::DoNotOptimize(std::copy(first, last, out));
+    } else {
+      benchmark::DoNotOptimize(std::ranges::copy(first, last, out));
+    }
+    benchmark::ClobberMemory();
+  }
+  set_counters(state, state.range(0));
+}
+
+template <class Kind, api Api>
+void bm_sort(benchmark::State& state) {
+  auto const input = make_input(state.range(0));
+  std::vector<int> output(input.size());
+  auto const first = Kind::wrap(output.data());
+  auto const last = Kind::wrap(output.data() + output.size());
+
+  for (auto _ : state) {
+    // restoring the unsorted input goes through raw pointers so it costs the same for every iterator kind
+    std::copy(input.begin(), input.end(), output.begin());
+    if constexpr (Api == api::std) {
+      std::sort(first, last);
+    } else {
+      std::ranges::sort(first, last);
+    }
+    benchmark::ClobberMemory();
+  }
+  set_counters(state, state.range(0));
+}
+
+template <class Kind, api Api>
+void bm_lower_bound(benchmark::State& state) {
+  constexpr static std::int64_t queries = 1024;
+
+  auto input = make_input(state.range(0));
+  std::ranges::sort(input);
+  auto const needles = make_input(queries);
+  auto const first = Kind::wrap(std::as_const(input).data());
+  auto const last = Kind::wrap(std::as_const(input).data() + input.size());
+
+  for (auto _ : state) {
+    for (int needle : needles) {
+      if constexpr (Api == api::std) {
+        benchmark::DoNotOptimize(std::lower_bound(first, last, needle));
+      } else {
+        benchmark::DoNotOptimize(std::ranges::lower_bound(first, last, needle));
+      }
+    }
+  }
+  set_counters(state, queries);
+}
+
+template <class Kind, api Api>
+void bm_transform(benchmark::State& state) {
+  auto const input = make_input(state.range(0));
+  std::vector<int> output(input.size());
+  auto const first = Kind::wrap(input.data());
+  auto const last = Kind::wrap(input.data() + input.size());
+  auto const out = Kind::wrap(output.data());
+  constexpr auto op = [](int value) noexcept { return 3 * value + 1; };
+
+  for (auto _ : state) {
+    if constexpr (Api == api::std) {
+      benchmark::DoNotOptimize(std::transform(first, last, out, op));
+    } else {
+      benchmark::DoNotOptimize(std::ranges::transform(first, last, out, op));
+    }
+    benchmark::ClobberMemory();
+  }
+  set_counters(state, state.range(0));
+}
+
+void sizes(benchmark::internal::Benchmark* bm) { bm->RangeMultiplier(8)->Range(1 << 10, 1 << 20); }
+
+}  // namespace
+
+// registered next to each other so that the raw pointer baseline is printed right above the facade results
+#define ITERF_BENCHMARK_KINDS(name, ...)                                                   \
+  BENCHMARK_TEMPLATE(name, raw_pointer __VA_OPT__(, ) __VA_ARGS__)->Apply(sizes);          \
+  BENCHMARK_TEMPLATE(name, random_access_facade __VA_OPT__(, ) __VA_ARGS__)->Apply(sizes); \
+  BENCHMARK_TEMPLATE(name, contiguous_facade __VA_OPT__(, ) __VA_ARGS__)->Apply(sizes)
+
+ITERF_BENCHMARK_KINDS(bm_accumulate);
+ITERF_BENCHMARK_KINDS(bm_find, api::std);
+ITERF_BENCHMARK_KINDS(bm_find, api::ranges);
+ITERF_BENCHMARK_KINDS(bm_copy, api::std);
+ITERF_BENCHMARK_KINDS(bm_copy, api::ranges);
+ITERF_BENCHMARK_KINDS(bm_sort, api::std);
+ITERF_BENCHMARK_KINDS(bm_sort, api::ranges);
+ITERF_BENCHMARK_KINDS(bm_lower_bound, api::std);
+ITERF_BENCHMARK_KINDS(bm_lower_bound, api::ranges);
+ITERF_BENCHMARK_KINDS(bm_transform, api::std);
+ITERF_BENCHMARK_KINDS(bm_transform, api::ranges);
@@ -0,0 +1,430 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+/// \brief Makes functors which are not assignable, e.g. capturing lambdas, assignable so iterators stay copyable
+template <std::copy_constructible F>
+class semiregular_box {
+ public:
+  constexpr semiregular_box() noexcept = default;
+  constexpr explicit semiregular_box(F fn) noexcept(std::is_nothrow_move_constructible_v<F>) : fn_(std::move(fn)) {}
+  constexpr semiregular_box(semiregular_box const&) = default;
+  constexpr semiregular_box(semiregular_box&&) noexcept(std::is_nothrow_move_constructible_v<F>) = default;
+  constexpr ~semiregular_box() = default;
+
+  constexpr auto operator=(semiregular_box const& other) noexcept(std::is_nothrow_copy_constructible_v<F>)
+      -> semiregular_box& {
+    if (this != std::addressof(other)) assign(other.fn_);
+    return *this;
+  }
+  constexpr auto operator=(semiregular_box&& other) noexcept(std::is_nothrow_move_constructible_v<F>)
+      -> semiregular_box& {
+    if (this != std::addressof(other)) assign(std::move(other.fn_));
+    return *this;
+  }
+
+  [[nodiscard]] constexpr auto get() const noexcept -> F const& { return *fn_; }
+
+  template <class... Args>
+  constexpr auto operator()(Args&&... args) const noexcept(std::is_nothrow_invocable_v<F const&, Args...>)
+      -> std::invoke_result_t<F const&, Args...> {
+    return std::invoke(*fn_, std::forward<Args>(args)...);
+  }
+
+ private:
+  std::optional<F> fn_{};
+
+  template <class Optional>
+  constexpr void assign(Optional&& other) {
+    if (other) {
+      fn_.emplace(*std::forward<Optional>(other));
+    } else {
+      fn_.reset();
+    }
+  }
+};
+
+template <class F>
+using semiregular_t = std::conditional_t<std::semiregular<F>, F, semiregular_box<F>>;
+
+template <class F>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto unbox(F const& fn) noexcept -> F const& {
+  return fn;
+}
+template <class F>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto unbox(semiregular_box<F> const& fn) noexcept -> F const& {
+  return fn.get();
+}
+
+/**
+ * \brief Calls a default constructed `F` instead of storing it
+ *
+ * Two empty members of the same type cannot share an address, so a predicate pushed below a transform which stored
+ * the transform's functor would make the adaptor stack grow.
+ */
+template <class F>
+struct stateless_function {
+  constexpr stateless_function() noexcept = default;
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr stateless_function(F const& /*unused*/) noexcept {}
+
+  template <class... Args>
+  constexpr auto operator()(Args&&... args) const noexcept(std::is_nothrow_invocable_v<F const&, Args...>)
+      -> std::invoke_result_t<F const&, Args...> {
+    F const fn{};
+    return std::invoke(fn, std::forward<Args>(args)...);
+  }
+};
+
+template <class F>
+using fused_t = std::conditional_t<std::is_empty_v<F> && std::default_initializable<F>, stateless_function<F>, F>;
+
+/// \brief `second(first(value))`, fused transforms and predicates pushed below a transform
+template <class F, class G>
+struct composed_function {
+  [[no_unique_address]] fused_t<F> first;
+  [[no_unique_address]] fused_t<G> second;
+
+  template <class T>
+  constexpr auto operator()(T&& value) const
+      noexcept(std::is_nothrow_invocable_v<F const&, T> &&
+               std::is_nothrow_invocable_v<G const&, std::invoke_result_t<F const&, T>>)
+          -> std::invoke_result_t<G const&, std::invoke_result_t<F const&, T>> {
+    return std::invoke(second, std::invoke(first, std::forward<T>(value)));
+  }
+};
+
+/// \brief `second(first(value))` of a predicate pushed below a transform, the transform reads `first` from it
+template <class F, class P>
+struct pushed_predicate : composed_function<F, P> {};
+
+/// \brief `first(value) && second(value)`, fused filters
+template <class P, class Q>
+struct conjunction {
+  [[no_unique_address]] fused_t<P> first;
+  [[no_unique_address]] fused_t<Q> second;
+
+  template <class T>
+  constexpr auto operator()(T&& value) const
+      noexcept(std::is_nothrow_invocable_v<P const&, T&> && std::is_nothrow_invocable_v<Q const&, T&>) -> bool {
+    return std::invoke(first, value) && std::invoke(second, value);
+  }
+};
+
+/// \brief Functor of the transform over a pushed predicate, filters fused after the push keep it as second predicate
+template <class F, class P>
+[[nodiscard]] constexpr auto pushed_function(pushed_predicate<F, P> const& pred) noexcept -> F const& {
+  return pred.first;
+}
+template <class Q, class F, class P>
+[[nodiscard]] constexpr auto pushed_function(conjunction<Q, pushed_predicate<F, P>> const& pred) noexcept
+    -> F const& {
+  return pred.second.first;
+}
+
+/// \brief A stateful functor of a transform which is already stored in the predicate of the filter below it
+// clang-format off
+template <class Iter, class F>
+concept shares_pushed_function = !std::is_empty_v<F> && requires(Iter const& it) {
+  { pushed_function(it.predicate()) } -> std::same_as<F const&>;
+};
+// clang-format on
+
+/// \brief Stands in for a functor which the iterator reads from its base instead of storing it
+template <class F>
+struct borrowed_function {
+  constexpr borrowed_function() noexcept = default;
+  constexpr explicit borrowed_function(F const& /*unused*/) noexcept {}
+};
+
+}  // namespace _ifacade_detail
+
+/** @defgroup adaptors Adaptors
+ *  Transforming and filtering iterators which fuse when they are stacked, see \ref make_transform_iterator and
+ *  \ref make_filter_iterator.
+ *  @{
+ */
+
+/**
+ * @brief Iterator which dereferences to <code>fn(*base)</code> and has the category of <code>Iter</code>
+ *
+ * Stateless functors take no space, so the iterator is as large as <code>Iter</code>. Functors which are not
+ * assignable, e.g. capturing lambdas, are stored in an optional to keep the iterator copyable. A transform over a
+ * filter pushed below it by \ref make_filter_iterator reads its functor from the filter's predicate instead of storing
+ * a second copy. Compares equal to the sentinels of <code>Iter</code>.
+ *
+ * @tparam Iter underlying iterator
+ * @tparam F functor applied to the elements of <code>Iter</code>
+ */
+template <std::input_iterator Iter, std::copy_constructible F>
+  requires(std::regular_invocable<F const&, std::iter_reference_t<Iter>>)
+class transform_iterator : public iterator_facade<transform_iterator<Iter, F>> {
+ public:
+  using iterator_type = Iter;
+  using function_type = F;
+  using reference = std::invoke_result_t<F const&, std::iter_reference_t<Iter>>;
+  using value_type = std::remove_cvref_t<reference>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  constexpr transform_iterator() = default;
+  constexpr transform_iterator(Iter base, F fn) noexcept(
+      std::is_nothrow_move_constructible_v<Iter>&& std::is_nothrow_move_constructible_v<F>)
+      : base_(std::move(base)), fn_(std::move(fn)) {}
+
+  [[nodiscard]] constexpr auto base() const noexcept -> Iter const& { return base_; }
+  [[nodiscard]] constexpr auto function() const noexcept -> F const& {
+    if constexpr (shares_function) {
+      return _ifacade_detail::pushed_function(base_.predicate());
+    } else {
+      return _ifacade_detail::unbox(fn_);
+    }
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const
+      noexcept(nothrow_dereference<Iter>&& std::is_nothrow_invocable_v<F const&, std::iter_reference_t<Iter>>)
+          -> reference {
+    return std::invoke(function(), *base_);
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() noexcept(nothrow_increment<Iter>) { ++base_; }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement() noexcept(nothrow_decrement<Iter>)
+    requires(std::bidirectional_iterator<Iter>)
+  {
+    --base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept(nothrow_advance<Iter>)
+    requires(std::random_access_iterator<Iter>)
+  {
+    base_ += n;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(transform_iterator const& other) const
+      noexcept(noexcept(base_ == other.base_)) -> bool
+    requires(std::equality_comparable<Iter>)
+  {
+    return base_ == other.base_;
+  }
+
+  template <std::sentinel_for<Iter> S>
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(S const& last) const noexcept(noexcept(base_ == last))
+      -> bool {
+    return base_ == last;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(transform_iterator const& other) const
+      noexcept(noexcept(other.base_ - base_)) -> difference_type
+    requires(std::sized_sentinel_for<Iter, Iter>)
+  {
+    return other.base_ - base_;
+  }
+
+ private:
+  constexpr static bool shares_function = _ifacade_detail::shares_pushed_function<Iter, F>;
+
+  Iter base_{};
+  [[no_unique_address]] std::conditional_t<shares_function, _ifacade_detail::borrowed_function<F>,
+                                           _ifacade_detail::semiregular_t<F>> fn_{};
+};
+
+/**
+ * @brief Iterator over the elements of [base, last) which satisfy <code>pred</code>, compares equal to
+ * <code>std::default_sentinel</code> at the end
+ *
+ * The iterator is bidirectional if <code>Iter</code> is, decrementing must not move before the first element which
+ * satisfies <code>pred</code>. Stateless predicates and empty sentinels take no space.
+ *
+ * @tparam Iter underlying iterator
+ * @tparam Sent end of the underlying sequence
+ * @tparam Pred predicate on the elements of <code>Iter</code>
+ */
+template <std::input_iterator Iter, std::sentinel_for<Iter> Sent, std::copy_constructible Pred>
+  requires(std::predicate<Pred const&, std::iter_reference_t<Iter>>)
+class filter_iterator : public iterator_facade<filter_iterator<Iter, Sent, Pred>> {
+ public:
+  using iterator_type = Iter;
+  using sentinel_type = Sent;
+  using predicate_type = Pred;
+  using value_type = std::iter_value_t<Iter>;
+  using reference = std::iter_reference_t<Iter>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  constexpr filter_iterator() = default;
+
+  /**
+   * @brief Iterator to the first element of [base, last) which satisfies <code>pred</code>
+   */
+  constexpr filter_iterator(Iter base, Sent last, Pred pred)
+      : base_(std::move(base)), last_(std::move(last)), pred_(std::move(pred)) {
+    satisfy();
+  }
+
+  [[nodiscard]] constexpr auto base() const noexcept -> Iter const& { return base_; }
+  [[nodiscard]] constexpr auto end_bound() const noexcept -> Sent const& { return last_; }
+  [[nodiscard]] constexpr auto predicate() const noexcept -> Pred const& { return _ifacade_detail::unbox(pred_); }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept(nothrow_dereference<Iter>)
+      -> reference {
+    return *base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() {
+    ++base_;
+    satisfy();
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement()
+    requires(std::bidirectional_iterator<Iter>)
+  {
+    do {
+      --base_;
+    } while (!std::invoke(pred_, *base_));
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(filter_iterator const& other) const
+      noexcept(noexcept(base_ == other.base_)) -> bool
+    requires(std::equality_comparable<Iter>)
+  {
+    return base_ == other.base_;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(std::default_sentinel_t /*unused*/) const
+      noexcept(noexcept(base_ == last_)) -> bool {
+    return base_ == last_;
+  }
+
+ private:
+  Iter base_{};
+  [[no_unique_address]] Sent last_{};
+  [[no_unique_address]] _ifacade_detail::semiregular_t<Pred> pred_{};
+
+  constexpr void satisfy() {
+    while (base_ != last_ && !std::invoke(pred_, *base_)) ++base_;
+  }
+};
+
+namespace _ifacade_detail {
+
+template <class T>
+inline constexpr bool is_transform_iterator = false;
+template <class Iter, class F>
+inline constexpr bool is_transform_iterator<transform_iterator<Iter, F>> = true;
+
+template <class T>
+inline constexpr bool is_filter_iterator = false;
+template <class Iter, class Sent, class Pred>
+inline constexpr bool is_filter_iterator<filter_iterator<Iter, Sent, Pred>> = true;
+
+/// \brief End of the sequence under a transform, transforms compare equal to the sentinels of their base
+template <class S>
+[[nodiscard]] constexpr auto transform_base_end(S last) {
+  if constexpr (is_transform_iterator<S>) {
+    return last.base();
+  } else {
+    return last;
+  }
+}
+
+}  // namespace _ifacade_detail
+
+/**
+ * @brief \ref transform_iterator applying <code>fn</code> to the elements of <code>it</code>
+ *
+ * Transforms of a transform fuse into one \ref transform_iterator over the innermost base applying both functors.
+ */
+template <std::input_iterator Iter, std::copy_constructible F>
+[[nodiscard]] constexpr auto make_transform_iterator(Iter it, F fn) {
+  if constexpr (_ifacade_detail::is_transform_iterator<Iter>) {
+    using function = _ifacade_detail::composed_function<typename Iter::function_type, F>;
+    return transform_iterator<typename Iter::iterator_type, function>(it.base(),
+                                                                      function{it.function(), std::move(fn)});
+  } else {
+    return transform_iterator<Iter, F>(std::move(it), std::move(fn));
+  }
+}
+
+/**
+ * @brief Iterator over the elements of [first, last) which satisfy <code>pred</code>, ending at
+ * <code>std::default_sentinel</code>
+ *
+ * Adaptors are flattened so that the stack stores one base iterator and one end bound:
+ *
+ * - a filter of a \ref filter_iterator ending at <code>std::default_sentinel</code> becomes one
+ *   \ref filter_iterator checking both predicates
+ * - a filter of a \ref transform_iterator is pushed below the transform, it becomes a \ref transform_iterator over a
+ *   filter of the transform's base testing <code>pred(fn(element))</code>, which in turn fuses with filters below.
+ *   A stateful <code>fn</code> is stored once, in the filter's predicate.
+ *
+ * @return \ref filter_iterator, or \ref transform_iterator over a \ref filter_iterator
+ */
+template <std::input_iterator Iter, std::sentinel_for<Iter> Sent, std::copy_constructible Pred>
+[[nodiscard]] constexpr auto make_filter_iterator(Iter first, Sent last, Pred pred) {
+  if constexpr (_ifacade_detail::is_filter_iterator<Iter> && std::same_as<Sent, std::default_sentinel_t>) {
+    using predicate = _ifacade_detail::conjunction<typename Iter::predicate_type, Pred>;
+    return filter_iterator<typename Iter::iterator_type, typename Iter::sentinel_type, predicate>(
+        first.base(), first.end_bound(), predicate{first.predicate(), std::move(pred)});
+  } else if constexpr (_ifacade_detail::is_transform_iterator<Iter>) {
+    using function = typename Iter::function_type;
+    auto filtered = make_filter_iterator(first.base(), _ifacade_detail::transform_base_end(std::move(last)),
+                                         _ifacade_detail::pushed_predicate<function, Pred>{
+                                             {first.function(), std::move(pred)}});
+    return transform_iterator<decltype(filtered), function>(std::move(filtered), first.function());
+  } else {
+    return filter_iterator<Iter, Sent, Pred>(std::move(first), std::move(last), std::move(pred));
+  }
+}
+
+/**
+ * @brief Range of <code>fn</code> applied to the elements of <code>range</code>, see \ref make_transform_iterator
+ *
+ * @return std::ranges::subrange of \ref transform_iterator, common and sized if <code>range</code> is
+ */
+template <std::ranges::input_range R, std::copy_constructible F>
+  requires(std::ranges::borrowed_range<R>)
+[[nodiscard]] constexpr auto transformed(R&& range, F fn) {
+  auto first = make_transform_iterator(std::ranges::begin(range), fn);
+  if constexpr (std::ranges::common_range<R>) {
+    return std::ranges::subrange(std::move(first), make_transform_iterator(std::ranges::end(range), std::move(fn)));
+  } else {
+    return std::ranges::subrange(std::move(first), std::ranges::end(range));
+  }
+}
+
+/**
+ * @brief Range of the elements of <code>range</code> which satisfy <code>pred</code>, see \ref make_filter_iterator
+ *
+ * @return std::ranges::subrange ending at <code>std::default_sentinel</code>
+ */
+template <std::ranges::input_range R, std::copy_constructible Pred>
+  requires(std::ranges::borrowed_range<R>)
+[[nodiscard]] constexpr auto filtered(R&& range, Pred pred) {
+  auto first = make_filter_iterator(std::ranges::begin(range), std::ranges::end(range), std::move(pred));
+  return std::ranges::subrange(std::move(first), std::default_sentinel);
+}
+
+/** @} */  // end of adaptors
+
+}  // namespace ITERATOR_FACADE_NS
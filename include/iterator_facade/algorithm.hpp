@@ -0,0 +1,406 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "iterator_facade.hpp"
+
+#ifndef ITERF_BLOCK_SIZE
+/// Maximum number of values requested from <code>next_block(n)</code> at a time
+#  define ITERF_BLOCK_SIZE 256
+#endif
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+/// \brief Contiguous local iterators are replaced by raw pointers so that the inner loops are plain pointer loops
+template <std::input_or_output_iterator It>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto unwrap(It const& it) noexcept(!std::contiguous_iterator<It> &&
+                                                                             std::is_nothrow_copy_constructible_v<It>) {
+  if constexpr (std::contiguous_iterator<It>) {
+    return std::to_address(it);
+  } else {
+    return it;
+  }
+}
+
+/// \brief Inverse of \ref unwrap, maps the unwrapped position `pos` of `it` back to the local iterator type
+template <std::input_or_output_iterator It, class Unwrapped>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto rewrap(It const& it, Unwrapped const& unwrapped,
+                                                        Unwrapped const& pos) -> It {
+  if constexpr (std::contiguous_iterator<It>) {
+    return it + (pos - unwrapped);
+  } else {
+    return pos;
+  }
+}
+
+/// \brief Call `fn(local_first, local_last)` for every segment overlapping [first, last)
+template <segmented_iterator I, class Fn>
+constexpr void for_each_segment(I const& first, I const& last, Fn fn) {
+  auto segment = first.segment();
+  auto const last_segment = last.segment();
+  if (segment == last_segment) {
+    fn(first.local(), last.local());
+    return;
+  }
+
+  fn(first.local(), first.segment_end(segment));
+  for (++segment; segment != last_segment; ++segment) fn(first.segment_begin(segment), first.segment_end(segment));
+  fn(first.segment_begin(last_segment), last.local());
+}
+
+/// \brief Call `fn(local_first, local_last)` for every segment overlapping [first, last) until it returns a local
+/// iterator other than `local_last`
+template <segmented_iterator I, class Fn>
+constexpr auto find_in_segments(I const& first, I const& last, Fn fn) -> I {
+  auto segment = first.segment();
+  auto const last_segment = last.segment();
+  if (segment == last_segment) return first.compose(segment, fn(first.local(), last.local()));
+
+  auto local_last = first.segment_end(segment);
+  if (auto found = fn(first.local(), local_last); found != local_last) return first.compose(segment, found);
+  for (++segment; segment != last_segment; ++segment) {
+    local_last = first.segment_end(segment);
+    if (auto found = fn(first.segment_begin(segment), local_last); found != local_last) {
+      return first.compose(segment, found);
+    }
+  }
+
+  if (auto found = fn(first.segment_begin(last_segment), last.local()); found != last.local()) {
+    return first.compose(last_segment, found);
+  }
+  return last;
+}
+
+template <class I, class S>
+concept segmented_range = segmented_iterator<I> && std::same_as<I, S>;
+
+// blocks can only be requested if the number of remaining values is known or the sentinel is the end of the sequence
+template <class I, class S>
+concept block_range = block_iterator<I> && (std::sized_sentinel_for<S, I> || std::same_as<S, std::default_sentinel_t>);
+
+// the standard library only replaces copies, comparisons and fills of raw pointers with memmove, memcmp and memset,
+// std::ranges::copy of libstdc++ 12 not even from const to mutable pointers
+template <class I, class S>
+concept contiguous_range = std::contiguous_iterator<I> && std::sized_sentinel_for<S, I>;
+
+/// \brief Copy [first, last) to `out` and advance `out` past the copy, contiguous ranges are written with one
+/// `write_n` call to bulk output iterators
+template <std::input_iterator I, class O>
+constexpr void copy_to(I first, I last, O& out) {
+  if constexpr (std::contiguous_iterator<I> && bulk_output_iterator<O, std::iter_value_t<I>>) {
+    if (first != last) {
+      using value = std::iter_value_t<I>;
+      out.write_n(std::span<value const>(std::to_address(first), static_cast<std::size_t>(last - first)));
+    }
+  } else {
+    out = std::ranges::copy(std::move(first), std::move(last), std::move(out)).out;
+  }
+}
+
+/// \brief Call `fn(block_first, block_last)` with pointers to every block in [first, last)
+template <class I, class S, class Fn>
+  requires block_range<I, S>
+constexpr void for_each_block(I& first, S const& last, Fn fn) {
+  using difference_type = std::iter_difference_t<I>;
+  while (true) {
+    auto count = static_cast<difference_type>(ITERF_BLOCK_SIZE);
+    if constexpr (std::sized_sentinel_for<S, I>) {
+      count = std::min(count, static_cast<difference_type>(last - first));
+      if (count <= 0) return;
+    } else {
+      if (first == last) return;
+    }
+
+    auto&& block = first.next_block(count);
+    auto const size = std::ranges::distance(block);
+    if (size == 0) return;
+    auto const* const data = std::ranges::data(block);
+    fn(data, data + size);
+  }
+}
+
+}  // namespace _ifacade_detail
+
+/** @defgroup algorithms Facade aware algorithms
+ *  Algorithms which take advantage of optional iterator hooks and fall back to the usual element-wise loops otherwise.
+ *  Ranges of a \ref segmented_iterator (with an iterator as the sentinel) are traversed one segment at a time with
+ *  tight loops over local iterators (raw pointers if the local iterators are contiguous) instead of checking for the
+ *  end of a segment on every increment.
+ *  Ranges of a \ref block_iterator with a sized sentinel or <code>std::default_sentinel_t</code> are consumed a block
+ *  of at most <code>ITERF_BLOCK_SIZE</code> values at a time instead of dereferencing and incrementing per element.
+ *  Output iterators with a <code>write_n</code> hook (\ref bulk_output_iterator) receive contiguous ranges and blocks
+ *  as one batch from <code>copy</code> and buffered batches of results from <code>transform</code>.
+ *  Contiguous iterators with a sized sentinel are replaced by raw pointers, for which the standard library copies,
+ *  compares and fills trivial types with <code>memmove</code>, <code>memcmp</code> and <code>memset</code>.
+ *  @{
+ */
+
+/**
+ * @brief Apply `f` to every element in [first, last)
+ *
+ * @return f
+ */
+template <std::input_iterator I, std::sentinel_for<I> S, class F>
+constexpr auto for_each(I first, S last, F f) -> F {
+  if constexpr (_ifacade_detail::segmented_range<I, S>) {
+    _ifacade_detail::for_each_segment(first, last, [&f](auto const& local_first, auto const& local_last) {
+      auto const end = _ifacade_detail::unwrap(local_last);
+      for (auto it = _ifacade_detail::unwrap(local_first); it != end; ++it) std::invoke(f, *it);
+    });
+  } else if constexpr (_ifacade_detail::block_range<I, S>) {
+    _ifacade_detail::for_each_block(first, last, [&f](auto block_first, auto block_last) {
+      for (; block_first != block_last; ++block_first) std::invoke(f, *block_first);
+    });
+  } else {
+    for (; first != last; ++first) std::invoke(f, *first);
+  }
+  return f;
+}
+
+/**
+ * @brief Copy [first, last) to `out`
+ *
+ * @return output iterator past the last copied element
+ */
+template <std::input_iterator I, std::sentinel_for<I> S, std::weakly_incrementable O>
+  requires std::indirectly_copyable<I, O>
+constexpr auto copy(I first, S last, O out) -> O {
+  if constexpr (_ifacade_detail::segmented_range<I, S>) {
+    _ifacade_detail::for_each_segment(first, last, [&out](auto const& local_first, auto const& local_last) {
+      _ifacade_detail::copy_to(_ifacade_detail::unwrap(local_first), _ifacade_detail::unwrap(local_last), out);
+    });
+    return out;
+  } else if constexpr (_ifacade_detail::block_range<I, S>) {
+    _ifacade_detail::for_each_block(first, last, [&out](auto block_first, auto block_last) {
+      _ifacade_detail::copy_to(block_first, block_last, out);
+    });
+    return out;
+  } else if constexpr (_ifacade_detail::contiguous_range<I, S> && std::contiguous_iterator<O>) {
+    auto const n = last - first;
+    if (n > 0) {
+      auto const* const data = std::to_address(first);
+      std::copy(data, data + n, std::to_address(out));
+    }
+    return out + n;
+  } else if constexpr (_ifacade_detail::contiguous_range<I, S> && bulk_output_iterator<O, std::iter_value_t<I>>) {
+    auto const* const data = std::to_address(first);
+    _ifacade_detail::copy_to(data, data + (last - first), out);
+    return out;
+  } else {
+    return std::ranges::copy(std::move(first), std::move(last), std::move(out)).out;
+  }
+}
+
+/**
+ * @brief Write `f(value)` for every value in [first, last) to `out`
+ *
+ * Trivially copyable results for a \ref bulk_output_iterator are collected in a buffer of
+ * <code>ITERF_BLOCK_SIZE</code> values which is handed to <code>write_n</code> whenever it is full.
+ *
+ * @return output iterator past the last written element
+ */
+template <std::input_iterator I, std::sentinel_for<I> S, std::weakly_incrementable O, std::copy_constructible F>
+  requires std::indirectly_writable<O, std::indirect_result_t<F&, I>>
+constexpr auto transform(I first, S last, O out, F f) -> O {
+  using result = std::remove_cvref_t<std::indirect_result_t<F&, I>>;
+  if constexpr (bulk_output_iterator<O, result> && std::is_trivially_copyable_v<result> &&
+                std::default_initializable<result>) {
+    std::array<result, ITERF_BLOCK_SIZE> buffer;
+    std::size_t size = 0;
+    ::ITERATOR_FACADE_NS::for_each(std::move(first), std::move(last), [&](auto&& value) {
+      buffer[size] = std::invoke(f, std::forward<decltype(value)>(value));
+      if (++size == buffer.size()) {
+        out.write_n(std::span<result const>(buffer.data(), size));
+        size = 0;
+      }
+    });
+    if (size != 0) out.write_n(std::span<result const>(buffer.data(), size));
+    return out;
+  } else {
+    return std::ranges::transform(std::move(first), std::move(last), std::move(out), std::move(f)).out;
+  }
+}
+
+/**
+ * @brief Assign `value` to every element in [first, last)
+ *
+ * @return iterator equal to `last`
+ */
+template <class T, std::output_iterator<T const&> I, std::sentinel_for<I> S>
+constexpr auto fill(I first, S last, T const& value) -> I {
+  if constexpr (_ifacade_detail::segmented_range<I, S>) {
+    _ifacade_detail::for_each_segment(first, last, [&value](auto const& local_first, auto const& local_last) {
+      std::ranges::fill(_ifacade_detail::unwrap(local_first), _ifacade_detail::unwrap(local_last), value);
+    });
+    return last;
+  } else if constexpr (_ifacade_detail::contiguous_range<I, S>) {
+    auto const n = last - first;
+    if (n > 0) {
+      auto* const data = std::to_address(first);
+      std::fill(data, data + n, value);
+    }
+    return first + n;
+  } else {
+    return std::ranges::fill(std::move(first), std::move(last), value);
+  }
+}
+
+/**
+ * @brief Compare [first1, last1) and [first2, last2) element-wise
+ *
+ * @return true if both ranges have the same length and equal elements
+ */
+template <std::input_iterator I1, std::sentinel_for<I1> S1, std::input_iterator I2, std::sentinel_for<I2> S2>
+  requires std::indirectly_comparable<I1, I2, std::ranges::equal_to>
+constexpr auto equal(I1 first1, S1 last1, I2 first2, S2 last2) -> bool {
+  if constexpr (_ifacade_detail::contiguous_range<I1, S1> && _ifacade_detail::contiguous_range<I2, S2>) {
+    auto const n = last1 - first1;
+    if (n != last2 - first2) return false;
+    if (n == 0) return true;
+    auto const* const data = std::to_address(first1);
+    return std::equal(data, data + n, std::to_address(first2));
+  } else {
+    return std::ranges::equal(std::move(first1), std::move(last1), std::move(first2), std::move(last2));
+  }
+}
+
+/**
+ * @brief Find the first element in [first, last) equal to `value`
+ *
+ * @return iterator to the found element or iterator equal to `last`
+ */
+template <std::input_iterator I, std::sentinel_for<I> S, class T>
+  requires std::indirect_binary_predicate<std::ranges::equal_to, I, T const*>
+constexpr auto find(I first, S last, T const& value) -> I {
+  if constexpr (_ifacade_detail::segmented_range<I, S>) {
+    return _ifacade_detail::find_in_segments(first, last, [&value](auto const& local_first, auto const& local_last) {
+      auto const unwrapped = _ifacade_detail::unwrap(local_first);
+      auto const found = std::ranges::find(unwrapped, _ifacade_detail::unwrap(local_last), value);
+      return _ifacade_detail::rewrap(local_first, unwrapped, found);
+    });
+  } else {
+    return std::ranges::find(std::move(first), std::move(last), value);
+  }
+}
+
+/**
+ * @brief Left fold of [first, last) with `op`, starting from `init`
+ *
+ * @return the folded value
+ */
+template <std::input_iterator I, std::sentinel_for<I> S, class T, class Op = std::plus<>>
+constexpr auto accumulate(I first, S last, T init, Op op = {}) -> T {
+  if constexpr (_ifacade_detail::segmented_range<I, S>) {
+    _ifacade_detail::for_each_segment(first, last, [&init, &op](auto const& local_first, auto const& local_last) {
+      auto const end = _ifacade_detail::unwrap(local_last);
+      for (auto it = _ifacade_detail::unwrap(local_first); it != end; ++it) {
+        init = std::invoke(op, std::move(init), *it);
+      }
+    });
+  } else if constexpr (_ifacade_detail::block_range<I, S>) {
+    _ifacade_detail::for_each_block(first, last, [&init, &op](auto block_first, auto block_last) {
+      for (; block_first != block_last; ++block_first) init = std::invoke(op, std::move(init), *block_first);
+    });
+  } else {
+    for (; first != last; ++first) init = std::invoke(op, std::move(init), *first);
+  }
+  return init;
+}
+
+/** @} */  // end of algorithms
+
+/** @defgroup partitioning Range partitioning
+ *  Split ranges into subranges, e.g. to hand them to a thread pool. Random access iterators with a sized sentinel are
+ *  split in O(1) per subrange with <code>advance</code> and <code>distance_to</code>, other iterators in a single pass
+ *  over the range which records the boundaries.
+ *  @{
+ */
+
+/**
+ * @brief Split [first, last) into at most `n` non-empty subranges whose sizes differ by at most one
+ *
+ * The size of the range is needed up front: it is computed in O(1) for sized sentinels, taken from `size_hint` if
+ * given and positive, or counted in an extra pass otherwise. If the hint is too small the excess elements end up in
+ * the last subrange, if it is too large fewer subranges are returned.
+ *
+ * @return subranges in order, empty if [first, last) is empty or `n` is 0
+ */
+template <std::forward_iterator I, std::sentinel_for<I> S>
+[[nodiscard]] constexpr auto split(I first, S last, std::size_t n,
+                                   std::optional<std::iter_difference_t<I>> size_hint = std::nullopt)
+    -> std::vector<std::ranges::subrange<I>> {
+  using difference_type = std::iter_difference_t<I>;
+
+  difference_type size = 0;
+  if constexpr (std::sized_sentinel_for<S, I>) {
+    size = last - first;
+  } else {
+    // a hint of 0 would drop every element of a non-empty range, so it is ignored like a negative one
+    size = size_hint && *size_hint > 0 ? *size_hint : std::ranges::distance(first, last);
+  }
+
+  std::vector<std::ranges::subrange<I>> result;
+  if (size <= 0 || n == 0) return result;
+
+  auto const count = std::min(static_cast<difference_type>(n), size);
+  auto const base = size / count;
+  auto const remainder = size % count;
+  result.reserve(static_cast<std::size_t>(count));
+  for (difference_type i = 0; i < count && first != last; ++i) {
+    // the last subrange takes everything that is left in case the size hint was too small
+    I chunk_last = i + 1 == count ? std::ranges::next(first, last)
+                                  : std::ranges::next(first, base + (i < remainder ? 1 : 0), last);
+    result.emplace_back(first, chunk_last);
+    first = std::move(chunk_last);
+  }
+  return result;
+}
+
+/**
+ * @brief Split [first, last) into subranges of `k` elements, the last one may be shorter
+ *
+ * @return subranges in order, empty if [first, last) is empty or `k` is not positive
+ */
+template <std::forward_iterator I, std::sentinel_for<I> S>
+[[nodiscard]] constexpr auto chunks_of(I first, S last, std::iter_difference_t<I> k)
+    -> std::vector<std::ranges::subrange<I>> {
+  std::vector<std::ranges::subrange<I>> result;
+  if (k <= 0) return result;
+  if constexpr (std::sized_sentinel_for<S, I>) {
+    auto const size = last - first;
+    if (size > 0) result.reserve(static_cast<std::size_t>((size + k - 1) / k));
+  }
+
+  while (first != last) {
+    I chunk_last = std::ranges::next(first, k, last);
+    result.emplace_back(first, chunk_last);
+    first = std::move(chunk_last);
+  }
+  return result;
+}
+
+/** @} */  // end of partitioning
+
+}  // namespace ITERATOR_FACADE_NS
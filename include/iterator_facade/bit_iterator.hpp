@@ -0,0 +1,364 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "algorithm.hpp"
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+// clang-format off
+// std::popcount and std::countr_zero only accept the standard unsigned integer types
+template <class W>
+concept bit_word = std::unsigned_integral<std::remove_const_t<W>> && !std::same_as<std::remove_const_t<W>, bool> &&
+                   std::same_as<std::remove_const_t<W>, std::make_unsigned_t<std::remove_const_t<W>>>;
+// clang-format on
+
+template <class W>
+inline constexpr unsigned word_bits = static_cast<unsigned>(std::numeric_limits<W>::digits);
+
+/// \brief Mask of the lowest `n` bits, n <= digits
+template <class W>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto low_mask(unsigned n) noexcept -> W {
+  return n == word_bits<W> ? static_cast<W>(~W{0}) : static_cast<W>((W{1} << n) - 1U);
+}
+
+/// \brief Mask of the bits at and above `n`, n < digits
+template <class W>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto high_mask(unsigned n) noexcept -> W {
+  return static_cast<W>(static_cast<W>(~W{0}) << n);
+}
+
+/// \brief Read `count` bits, 0 < count <= digits, starting at bit `offset` of `word`, the bits may span two words
+template <class W>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto read_bits(W const* word, unsigned offset, unsigned count) noexcept
+    -> W {
+  auto bits = static_cast<W>(word[0] >> offset);
+  if (offset + count > word_bits<W>) bits = static_cast<W>(bits | (word[1] << (word_bits<W> - offset)));
+  return static_cast<W>(bits & low_mask<W>(count));
+}
+
+/// \brief Write the lowest `count` bits of `bits`, 0 < count <= digits, starting at bit `offset` of `word`
+template <class W>
+ITERF_ALWAYS_INLINE constexpr void write_bits(W* word, unsigned offset, unsigned count, W bits) noexcept {
+  auto const first = static_cast<W>(low_mask<W>(std::min(count, word_bits<W> - offset)) << offset);
+  word[0] = static_cast<W>((word[0] & ~first) | ((bits << offset) & first));
+  if (offset + count > word_bits<W>) {
+    auto const second = low_mask<W>(offset + count - word_bits<W>);
+    word[1] = static_cast<W>((word[1] & ~second) | ((bits >> (word_bits<W> - offset)) & second));
+  }
+}
+
+/// \brief Set or clear the bits of `mask` in `word`
+template <class W>
+ITERF_ALWAYS_INLINE constexpr void assign_bits(W& word, W mask, bool value) noexcept {
+  word = value ? static_cast<W>(word | mask) : static_cast<W>(word & ~mask);
+}
+
+}  // namespace _ifacade_detail
+
+/** @defgroup bits Bit iterator
+ *  Iterators over the bits of packed unsigned words, the first bit of a word is its least significant one, and
+ *  overloads of <code>count</code>, <code>find</code>, <code>find_first_of</code>, <code>copy</code> and
+ *  <code>fill</code> which process whole words at a time.
+ *  @{
+ */
+
+/**
+ * @brief Proxy reference to a single bit of a word
+ *
+ * @tparam Word unsigned word type
+ */
+template <_ifacade_detail::bit_word Word>
+  requires(!std::is_const_v<Word>)
+class bit_reference {
+ public:
+  using proxy_value_type = bool;
+
+  constexpr bit_reference(Word* word, Word mask) noexcept : word_(word), mask_(mask) {}
+  constexpr bit_reference(bit_reference const&) noexcept = default;
+  constexpr ~bit_reference() noexcept = default;
+
+  // assignments write through to the referenced bit
+  constexpr auto operator=(bool value) const noexcept -> bit_reference const& {
+    _ifacade_detail::assign_bits(*word_, mask_, value);
+    return *this;
+  }
+  // NOLINTNEXTLINE(cert-oop54-cpp)
+  constexpr auto operator=(bit_reference const& other) const noexcept -> bit_reference const& {
+    return *this = static_cast<bool>(other);
+  }
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  [[nodiscard]] constexpr operator bool() const noexcept { return (*word_ & mask_) != 0; }
+
+  constexpr void flip() const noexcept { *word_ = static_cast<Word>(*word_ ^ mask_); }
+
+  friend constexpr void swap(bit_reference lhs, bit_reference rhs) noexcept {
+    bool const tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+
+ private:
+  Word* word_;
+  Word mask_;
+};
+
+/**
+ * @brief Random access iterator over the bits of an array of unsigned words
+ *
+ * The position is a word pointer and the bit offset within the word, <code>advance</code> and
+ * <code>distance_to</code> work on bit indices. Iterators over mutable words dereference to a \ref bit_reference,
+ * iterators over <code>const</code> words to <code>bool</code>.
+ *
+ * @tparam Word unsigned word type, <code>const</code> for read-only bits
+ */
+template <_ifacade_detail::bit_word Word = std::uint64_t>
+class bit_iterator : public iterator_facade<bit_iterator<Word>> {
+ public:
+  using word_type = std::remove_const_t<Word>;
+  using value_type = bool;
+  using reference = std::conditional_t<std::is_const_v<Word>, bool, bit_reference<word_type>>;
+  using difference_type = std::ptrdiff_t;
+
+  constexpr static unsigned word_bits = _ifacade_detail::word_bits<word_type>;
+
+  constexpr bit_iterator() noexcept = default;
+
+  /**
+   * @brief Iterator to bit <code>index</code> counted from the first bit of <code>words</code>
+   */
+  constexpr explicit bit_iterator(Word* words, difference_type index = 0) noexcept : word_(words) { advance(index); }
+
+  /**
+   * @brief Read-only iterator to the same bit as <code>other</code>
+   */
+  template <class Other>
+    requires(std::is_const_v<Word> && std::same_as<Other, word_type>)
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr bit_iterator(bit_iterator<Other> const& other) noexcept : word_(other.word()), offset_(other.offset()) {}
+
+  /**
+   * @brief Word containing the referenced bit
+   */
+  [[nodiscard]] constexpr auto word() const noexcept -> Word* { return word_; }
+
+  /**
+   * @brief Offset of the referenced bit in \ref word, 0 is the least significant bit
+   */
+  [[nodiscard]] constexpr auto offset() const noexcept -> unsigned { return offset_; }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept -> reference {
+    auto const mask = static_cast<word_type>(word_type{1} << offset_);
+    if constexpr (std::is_const_v<Word>) {
+      return (*word_ & mask) != 0;
+    } else {
+      return {word_, mask};
+    }
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() noexcept {
+    if (++offset_ == word_bits) {
+      offset_ = 0;
+      ++word_;
+    }
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement() noexcept {
+    if (offset_ == 0) {
+      offset_ = word_bits;
+      --word_;
+    }
+    --offset_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept {
+    constexpr auto bits = static_cast<difference_type>(word_bits);
+    auto const index = static_cast<difference_type>(offset_) + n;
+    // floor division so that negative indices move to previous words
+    auto words = index / bits;
+    auto offset = index % bits;
+    if (offset < 0) {
+      offset += bits;
+      --words;
+    }
+    word_ += words;
+    offset_ = static_cast<unsigned>(offset);
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(bit_iterator const& other) const noexcept -> bool {
+    return word_ == other.word_ && offset_ == other.offset_;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(bit_iterator const& other) const noexcept
+      -> difference_type {
+    return (other.word_ - word_) * static_cast<difference_type>(word_bits) +
+           (static_cast<difference_type>(other.offset_) - static_cast<difference_type>(offset_));
+  }
+
+ private:
+  Word* word_ = nullptr;
+  unsigned offset_ = 0;
+};
+
+/**
+ * @brief Range over the first <code>size</code> bits of the contiguous range <code>words</code>, all bits by default
+ *
+ * @return std::ranges::subrange<bit_iterator<std::remove_reference_t<std::ranges::range_reference_t<R>>>>
+ */
+template <std::ranges::contiguous_range R>
+  requires(std::ranges::borrowed_range<R> && std::ranges::sized_range<R> &&
+           _ifacade_detail::bit_word<std::remove_reference_t<std::ranges::range_reference_t<R>>>)
+[[nodiscard]] constexpr auto bits(R&& words, std::size_t size = std::dynamic_extent) noexcept
+    -> std::ranges::subrange<bit_iterator<std::remove_reference_t<std::ranges::range_reference_t<R>>>> {
+  using iterator = bit_iterator<std::remove_reference_t<std::ranges::range_reference_t<R>>>;
+  auto* const data = std::ranges::data(words);
+  if (size == std::dynamic_extent) size = std::ranges::size(words) * iterator::word_bits;
+  return {iterator(data), iterator(data, static_cast<std::ptrdiff_t>(size))};
+}
+
+/**
+ * @brief Number of bits in [first, last) equal to <code>value</code>, counted a word at a time
+ */
+template <class Word>
+[[nodiscard]] constexpr auto count(bit_iterator<Word> first, bit_iterator<Word> last, bool value) noexcept
+    -> std::ptrdiff_t {
+  using word_type = typename bit_iterator<Word>::word_type;
+  if (first == last) return 0;
+
+  auto const head = _ifacade_detail::high_mask<word_type>(first.offset());
+  auto const tail = _ifacade_detail::low_mask<word_type>(last.offset());
+  std::ptrdiff_t ones = 0;
+  if (first.word() == last.word()) {
+    ones = std::popcount(static_cast<word_type>(*first.word() & head & tail));
+  } else {
+    ones = std::popcount(static_cast<word_type>(*first.word() & head));
+    for (auto const* word = first.word() + 1; word != last.word(); ++word) ones += std::popcount(*word);
+    // the last word is only read if the range ends inside of it
+    if (last.offset() != 0) ones += std::popcount(static_cast<word_type>(*last.word() & tail));
+  }
+  return value ? ones : (last - first) - ones;
+}
+
+/**
+ * @brief First bit in [first, last) equal to <code>value</code>, searched a word at a time
+ *
+ * @return iterator to the found bit or <code>last</code>
+ */
+template <class Word>
+[[nodiscard]] constexpr auto find(bit_iterator<Word> first, bit_iterator<Word> last, bool value) noexcept
+    -> bit_iterator<Word> {
+  using word_type = typename bit_iterator<Word>::word_type;
+  if (first == last) return last;
+
+  // the searched bits are set in the candidates
+  auto const candidates = [value](word_type word) { return value ? word : static_cast<word_type>(~word); };
+  auto const found = [](Word* word, word_type bits) { return bit_iterator<Word>(word, std::countr_zero(bits)); };
+
+  auto* word = first.word();
+  auto bits = static_cast<word_type>(candidates(*word) & _ifacade_detail::high_mask<word_type>(first.offset()));
+  if (word == last.word()) {
+    bits = static_cast<word_type>(bits & _ifacade_detail::low_mask<word_type>(last.offset()));
+    return bits != 0 ? found(word, bits) : last;
+  }
+  if (bits != 0) return found(word, bits);
+
+  for (++word; word != last.word(); ++word) {
+    bits = candidates(*word);
+    if (bits != 0) return found(word, bits);
+  }
+  if (last.offset() != 0) {
+    bits = static_cast<word_type>(candidates(*word) & _ifacade_detail::low_mask<word_type>(last.offset()));
+    if (bits != 0) return found(word, bits);
+  }
+  return last;
+}
+
+/**
+ * @brief First bit in [first, last) equal to any of the bits in [values_first, values_last)
+ *
+ * Bits have two values, so the search is a word-wise \ref find of the value (or either value) occurring in
+ * [values_first, values_last).
+ *
+ * @return iterator to the found bit or <code>last</code>
+ */
+template <class Word, std::input_iterator I, std::sentinel_for<I> S>
+  requires(std::convertible_to<std::iter_reference_t<I>, bool>)
+[[nodiscard]] constexpr auto find_first_of(bit_iterator<Word> first, bit_iterator<Word> last, I values_first,
+                                           S values_last) -> bit_iterator<Word> {
+  bool zeros = false;
+  bool ones = false;
+  for (; values_first != values_last && !(zeros && ones); ++values_first) {
+    (static_cast<bool>(*values_first) ? ones : zeros) = true;
+  }
+  if (zeros && ones) return first;
+  if (!zeros && !ones) return last;
+  return ::ITERATOR_FACADE_NS::find(first, last, ones);
+}
+
+/**
+ * @brief Copy [first, last) to <code>out</code> a word at a time, the ranges may start at different bit offsets
+ *
+ * @return iterator past the last copied bit
+ */
+template <class Word, class OutWord>
+  requires(std::same_as<typename bit_iterator<Word>::word_type, OutWord>)
+constexpr auto copy(bit_iterator<Word> first, bit_iterator<Word> last, bit_iterator<OutWord> out) noexcept
+    -> bit_iterator<OutWord> {
+  constexpr auto word_bits = static_cast<std::ptrdiff_t>(bit_iterator<OutWord>::word_bits);
+  for (auto n = last - first; n > 0; n -= word_bits) {
+    auto const count = static_cast<unsigned>(std::min(n, word_bits));
+    _ifacade_detail::write_bits(out.word(), out.offset(), count,
+                                _ifacade_detail::read_bits<OutWord>(first.word(), first.offset(), count));
+    first += count;
+    out += count;
+  }
+  return out;
+}
+
+/**
+ * @brief Assign <code>value</code> to every bit in [first, last), whole words are filled at once
+ *
+ * @return <code>last</code>
+ */
+template <class Word>
+  requires(!std::is_const_v<Word>)
+constexpr auto fill(bit_iterator<Word> first, bit_iterator<Word> last, bool value) noexcept -> bit_iterator<Word> {
+  if (first == last) return last;
+
+  auto const head = _ifacade_detail::high_mask<Word>(first.offset());
+  auto const tail = _ifacade_detail::low_mask<Word>(last.offset());
+  if (first.word() == last.word()) {
+    _ifacade_detail::assign_bits(*first.word(), static_cast<Word>(head & tail), value);
+    return last;
+  }
+  _ifacade_detail::assign_bits(*first.word(), head, value);
+  std::fill(first.word() + 1, last.word(), value ? static_cast<Word>(~Word{0}) : Word{0});
+  if (last.offset() != 0) _ifacade_detail::assign_bits(*last.word(), tail, value);
+  return last;
+}
+
+/** @} */  // end of bits
+
+}  // namespace ITERATOR_FACADE_NS
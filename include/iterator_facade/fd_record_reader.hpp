@@ -0,0 +1,253 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#if __has_include(<unistd.h>)
+
+#  include <algorithm>
+#  include <bit>
+#  include <cerrno>
+#  include <concepts>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+#  include <iterator>
+#  include <memory>
+#  include <optional>
+#  include <stdexcept>
+#  include <string>
+#  include <string_view>
+#  include <system_error>
+
+#  include <fcntl.h>
+#  include <unistd.h>
+
+#  include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+/** @defgroup records Record reader
+ *  @{
+ */
+
+/// Position of the next record in the buffered data
+struct record_frame {
+  std::size_t offset;    ///< start of the record
+  std::size_t size;      ///< size of the record
+  std::size_t consumed;  ///< bytes to skip to the next record, including delimiters and prefixes
+};
+
+/**
+ * @brief Records terminated by a delimiter, by default lines, the delimiter is not part of the record
+ *
+ * The data after the last delimiter is the last record, so a missing final newline does not lose a line.
+ */
+struct line_framing {
+  char delimiter = '\n';
+
+  [[nodiscard]] auto find(std::string_view data) const noexcept -> std::optional<record_frame> {
+    auto const* end = static_cast<char const*>(std::memchr(data.data(), delimiter, data.size()));
+    if (end == nullptr) return std::nullopt;
+    auto const size = static_cast<std::size_t>(end - data.data());
+    return record_frame{0, size, size + 1};
+  }
+
+  [[nodiscard]] static auto last(std::string_view data) noexcept -> std::string_view { return data; }
+};
+
+/**
+ * @brief Records preceded by their length as an unsigned integer
+ *
+ * @tparam Length type of the length prefix
+ * @tparam Order byte order of the length prefix
+ */
+template <std::unsigned_integral Length = std::uint32_t, std::endian Order = std::endian::little>
+struct length_prefixed_framing {
+  [[nodiscard]] static auto find(std::string_view data) noexcept -> std::optional<record_frame> {
+    if (data.size() < sizeof(Length)) return std::nullopt;
+    Length length = 0;
+    std::memcpy(&length, data.data(), sizeof(Length));
+    if constexpr (Order != std::endian::native) length = byteswap(length);
+
+    if (data.size() - sizeof(Length) < length) return std::nullopt;
+    return record_frame{sizeof(Length), length, sizeof(Length) + length};
+  }
+
+  /**
+   * @throws std::runtime_error as trailing data is a truncated record
+   */
+  [[noreturn]] static auto last(std::string_view /*unused*/) -> std::string_view {
+    throw std::runtime_error("truncated length prefixed record");
+  }
+
+ private:
+  [[nodiscard]] static constexpr auto byteswap(Length value) noexcept -> Length {
+    std::uintmax_t wide = value;
+    std::uintmax_t result = 0;
+    for (std::size_t i = 0; i < sizeof(Length); ++i) {
+      result = (result << 8U) | (wide & 0xFFU);
+      wide >>= 8U;
+    }
+    return static_cast<Length>(result);
+  }
+};
+
+// clang-format off
+/// Splits buffered data into records, see \ref line_framing
+template <class T>
+concept record_framing = requires(T const& framing, std::string_view data) {
+  { framing.find(data) } -> std::same_as<std::optional<record_frame>>;
+  { framing.last(data) } -> std::convertible_to<std::string_view>;
+};
+// clang-format on
+
+/// Options of \ref fd_record_reader
+struct record_reader_options {
+  /// initial buffer size, the buffer grows when a record does not fit
+  std::size_t buffer_size = std::size_t{1} << 16U;
+  /// tell the kernel that the file is read sequentially so it reads ahead further
+  bool readahead = true;
+};
+
+/**
+ * @brief Single pass range of the records read from a file descriptor
+ *
+ * Reads into one reusable buffer and hands out <code>std::string_view</code>s into it, so records are not allocated
+ * and no locale is involved. A record stays valid until the iterator is incremented. Postfix increment copies the
+ * previous record into a <code>std::string</code>, the <code>value_type</code>.
+ *
+ * The file descriptor is not owned and can be a file, pipe or socket.
+ *
+ * @tparam Framing how records are delimited, \ref line_framing or \ref length_prefixed_framing
+ */
+template <record_framing Framing = line_framing>
+class fd_record_reader {
+ public:
+  class iterator : public iterator_facade<iterator> {
+   public:
+    using value_type = std::string;
+    using reference = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    explicit iterator(fd_record_reader* reader) noexcept : reader_(reader) {}
+
+    [[nodiscard]] auto dereference() const noexcept -> std::string_view { return reader_->current_; }
+    void increment() { reader_->next(); }
+    [[nodiscard]] auto equals(std::default_sentinel_t /*unused*/) const noexcept -> bool { return reader_->done_; }
+
+   private:
+    fd_record_reader* reader_ = nullptr;
+  };
+
+  /**
+   * @brief Read records from <code>fd</code>, which has to stay open while reading
+   */
+  explicit fd_record_reader(int fd, Framing framing = {}, record_reader_options const& options = {})
+      : fd_(fd),
+        framing_(std::move(framing)),
+        buffer_(std::make_unique_for_overwrite<char[]>(std::max<std::size_t>(options.buffer_size, 1))),
+        capacity_(std::max<std::size_t>(options.buffer_size, 1)) {
+#  ifdef POSIX_FADV_SEQUENTIAL
+    // fails for pipes and sockets, which have no readahead to tune
+    if (options.readahead) static_cast<void>(::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL));
+#  endif
+  }
+
+  fd_record_reader(fd_record_reader const&) = delete;
+  fd_record_reader(fd_record_reader&&) = delete;
+  auto operator=(fd_record_reader const&) -> fd_record_reader& = delete;
+  auto operator=(fd_record_reader&&) -> fd_record_reader& = delete;
+  ~fd_record_reader() = default;
+
+  /**
+   * @brief Iterator to the current record, reads the first record on the first call
+   *
+   * @throws std::system_error if reading fails
+   */
+  [[nodiscard]] auto begin() -> iterator {
+    if (!started_) {
+      started_ = true;
+      next();
+    }
+    return iterator(this);
+  }
+
+  [[nodiscard]] static auto end() noexcept -> std::default_sentinel_t { return {}; }
+
+  /**
+   * @brief Current size of the buffer, larger than the initial size if a record did not fit
+   */
+  [[nodiscard]] auto buffer_size() const noexcept -> std::size_t { return capacity_; }
+
+ private:
+  int fd_;
+  Framing framing_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t capacity_;
+  // unconsumed data is [first_, last_)
+  std::size_t first_ = 0;
+  std::size_t last_ = 0;
+  std::string_view current_{};
+  bool started_ = false;
+  bool eof_ = false;
+  bool done_ = false;
+
+  void next() {
+    while (true) {
+      std::string_view const data(buffer_.get() + first_, last_ - first_);
+      if (auto const frame = framing_.find(data)) {
+        current_ = data.substr(frame->offset, frame->size);
+        first_ += frame->consumed;
+        return;
+      }
+      if (eof_) {
+        if (data.empty()) {
+          current_ = {};
+          done_ = true;
+        } else {
+          current_ = framing_.last(data);
+          first_ = last_;
+        }
+        return;
+      }
+      fill();
+    }
+  }
+
+  void fill() {
+    // the current record is finished, so the partial record can move to the front
+    if (first_ != 0) {
+      std::memmove(buffer_.get(), buffer_.get() + first_, last_ - first_);
+      last_ -= first_;
+      first_ = 0;
+    }
+    if (last_ == capacity_) {
+      auto grown = std::make_unique_for_overwrite<char[]>(capacity_ * 2);
+      std::memcpy(grown.get(), buffer_.get(), last_);
+      buffer_ = std::move(grown);
+      capacity_ *= 2;
+    }
+
+    ::ssize_t read = 0;
+    do {
+      read = ::read(fd_, buffer_.get() + last_, capacity_ - last_);
+    } while (read < 0 && errno == EINTR);
+    if (read < 0) throw std::system_error(errno, std::generic_category(), "read");
+    if (read == 0) eof_ = true;
+    last_ += static_cast<std::size_t>(read);
+  }
+};
+
+/** @} */  // end of records
+
+}  // namespace ITERATOR_FACADE_NS
+
+#endif
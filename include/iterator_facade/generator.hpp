@@ -0,0 +1,314 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+/** @defgroup generator Generator
+ *  @{
+ */
+
+/**
+ * @brief Thread local cache of freed coroutine frames, bucketed by size
+ *
+ * Frames up to \ref max_pooled_size bytes are rounded up to a multiple of \ref granularity and kept in a free list
+ * per size when they are deallocated, so creating and destroying many short lived coroutines of the same few sizes
+ * only allocates from the heap until the pool is warm. Larger frames go straight to the heap.
+ */
+class frame_pool {
+ public:
+  constexpr static std::size_t granularity = 64;
+  constexpr static std::size_t max_pooled_size = 4096;
+
+  frame_pool() noexcept = default;
+  frame_pool(frame_pool const&) = delete;
+  frame_pool(frame_pool&&) = delete;
+  auto operator=(frame_pool const&) -> frame_pool& = delete;
+  auto operator=(frame_pool&&) -> frame_pool& = delete;
+
+  ~frame_pool() {
+    for (auto* head : free_) {
+      while (head != nullptr) ::operator delete(std::exchange(head, head->next));
+    }
+  }
+
+  /**
+   * @brief Pool of the calling thread, frames may be deallocated on another thread than they were allocated on
+   */
+  [[nodiscard]] static auto local() noexcept -> frame_pool& {
+    thread_local frame_pool pool;
+    return pool;
+  }
+
+  [[nodiscard]] auto allocate(std::size_t size) -> void* {
+    if (size > max_pooled_size) return ::operator new(size);
+    auto& head = free_[bucket(size)];
+    if (head == nullptr) return ::operator new(rounded(size));
+    --cached_;
+    return std::exchange(head, head->next);
+  }
+
+  void deallocate(void* ptr, std::size_t size) noexcept {
+    if (size > max_pooled_size) {
+      ::operator delete(ptr);
+      return;
+    }
+    auto& head = free_[bucket(size)];
+    head = ::new (ptr) free_block{head};
+    ++cached_;
+  }
+
+  /**
+   * @brief Number of freed frames kept for reuse
+   */
+  [[nodiscard]] auto cached() const noexcept -> std::size_t { return cached_; }
+
+ private:
+  struct free_block {
+    free_block* next;
+  };
+
+  std::array<free_block*, max_pooled_size / granularity> free_{};
+  std::size_t cached_ = 0;
+
+  [[nodiscard]] constexpr static auto bucket(std::size_t size) noexcept -> std::size_t {
+    return (std::max<std::size_t>(size, 1) - 1) / granularity;
+  }
+  [[nodiscard]] constexpr static auto rounded(std::size_t size) noexcept -> std::size_t {
+    return (bucket(size) + 1) * granularity;
+  }
+};
+
+/**
+ * @brief Stateless allocator which recycles memory through \ref frame_pool::local
+ */
+template <class T>
+struct recycling_allocator {
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  constexpr recycling_allocator() noexcept = default;
+  template <class U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr recycling_allocator(recycling_allocator<U> const& /*unused*/) noexcept {}
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T* {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+    return static_cast<T*>(frame_pool::local().allocate(n * sizeof(T)));
+  }
+  void deallocate(T* ptr, std::size_t n) noexcept { frame_pool::local().deallocate(ptr, n * sizeof(T)); }
+
+  template <class U>
+  [[nodiscard]] friend constexpr auto operator==(recycling_allocator const& /*unused*/,
+                                                 recycling_allocator<U> const& /*unused*/) noexcept -> bool {
+    return true;
+  }
+};
+
+namespace _ifacade_detail {
+
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) frame_block {
+  std::array<std::byte, __STDCPP_DEFAULT_NEW_ALIGNMENT__> bytes;
+};
+
+/// \brief Allocate coroutine frames with `Alloc`, stateful allocators are stored behind the frame for deallocation
+template <class Alloc>
+struct frame_allocation {
+  using allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<frame_block>;
+  using traits = std::allocator_traits<allocator>;
+
+  constexpr static bool stateless = traits::is_always_equal::value && std::default_initializable<allocator>;
+
+  static_assert(alignof(allocator) <= alignof(frame_block), "over-aligned allocators are not supported");
+
+  [[nodiscard]] constexpr static auto allocator_offset(std::size_t size) noexcept -> std::size_t {
+    return (size + alignof(allocator) - 1) / alignof(allocator) * alignof(allocator);
+  }
+  [[nodiscard]] constexpr static auto blocks(std::size_t size) noexcept -> std::size_t {
+    auto const bytes = stateless ? size : allocator_offset(size) + sizeof(allocator);
+    return (bytes + sizeof(frame_block) - 1) / sizeof(frame_block);
+  }
+
+  [[nodiscard]] static auto allocate(Alloc const& alloc, std::size_t size) -> void* {
+    allocator block_allocator(alloc);
+    void* frame = traits::allocate(block_allocator, blocks(size));
+    if constexpr (!stateless) ::new (static_cast<std::byte*>(frame) + allocator_offset(size)) allocator(block_allocator);
+    return frame;
+  }
+
+  static void deallocate(void* frame, std::size_t size) noexcept {
+    if constexpr (stateless) {
+      allocator block_allocator;
+      traits::deallocate(block_allocator, static_cast<frame_block*>(frame), blocks(size));
+    } else {
+      auto* stored = std::launder(reinterpret_cast<allocator*>(  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+          static_cast<std::byte*>(frame) + allocator_offset(size)));
+      allocator block_allocator(std::move(*stored));
+      stored->~allocator();
+      traits::deallocate(block_allocator, static_cast<frame_block*>(frame), blocks(size));
+    }
+  }
+};
+
+}  // namespace _ifacade_detail
+
+/**
+ * @brief Lazy single pass range of the values a coroutine yields with <code>co_yield</code>
+ *
+ * The coroutine starts on <code>begin()</code> and runs until its next <code>co_yield</code> on every increment,
+ * exceptions escaping the coroutine are rethrown from <code>begin()</code> or the increment. Yielded values are not
+ * copied, the iterator refers to the yielded object until it is incremented.
+ *
+ * Coroutine frames are allocated with <code>Alloc</code>. A default constructible allocator is used when the coroutine
+ * has no allocator parameter, any other allocator is passed as <code>std::allocator_arg, alloc</code> before the other
+ * coroutine parameters and is stored in the frame until it is freed. GCC 12 reports a false
+ * <code>-Wmismatched-new-delete</code> at <code>-O0</code> in coroutines taking an allocator argument.
+ *
+ * @tparam T yielded type, <code>T&</code> or <code>T&&</code> to yield references
+ * @tparam Alloc allocator for coroutine frames, e.g. \ref recycling_allocator or a per thread arena
+ */
+template <class T, class Alloc = std::allocator<std::byte>>
+class generator : public std::ranges::view_interface<generator<T, Alloc>> {
+ public:
+  using value_type = std::remove_cvref_t<T>;
+  using reference = std::conditional_t<std::is_reference_v<T>, T, T const&>;
+
+  class promise_type {
+   public:
+    [[nodiscard]] auto get_return_object() noexcept -> generator {
+      return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    [[nodiscard]] static auto final_suspend() noexcept -> std::suspend_always { return {}; }
+
+    auto yield_value(reference value) noexcept -> std::suspend_always {
+      value_ = std::addressof(value);
+      return {};
+    }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    // co_await is not meaningful in a generator
+    template <class U>
+    auto await_transform(U&& value) -> U&& = delete;
+
+    [[nodiscard]] static auto operator new(std::size_t size) -> void*
+      requires(std::default_initializable<Alloc>)
+    {
+      return _ifacade_detail::frame_allocation<Alloc>::allocate(Alloc{}, size);
+    }
+
+    template <class... Args>
+    [[nodiscard]] static auto operator new(std::size_t size, std::allocator_arg_t /*unused*/, Alloc const& alloc,
+                                           Args const&... /*unused*/) -> void* {
+      return _ifacade_detail::frame_allocation<Alloc>::allocate(alloc, size);
+    }
+
+    // member function coroutines receive the object first
+    template <class This, class... Args>
+    [[nodiscard]] static auto operator new(std::size_t size, This const& /*unused*/, std::allocator_arg_t /*unused*/,
+                                           Alloc const& alloc, Args const&... /*unused*/) -> void* {
+      return _ifacade_detail::frame_allocation<Alloc>::allocate(alloc, size);
+    }
+
+    static void operator delete(void* frame, std::size_t size) noexcept {
+      _ifacade_detail::frame_allocation<Alloc>::deallocate(frame, size);
+    }
+
+   private:
+    friend class generator;
+
+    std::add_pointer_t<reference> value_ = nullptr;
+    std::exception_ptr exception_{};
+
+    void rethrow() {
+      if (exception_) std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+  };
+
+  class iterator : public iterator_facade<iterator> {
+   public:
+    using value_type = generator::value_type;
+    using reference = generator::reference;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() noexcept = default;
+    explicit iterator(std::coroutine_handle<promise_type> coroutine) noexcept : coroutine_(coroutine) {}
+
+    [[nodiscard]] auto dereference() const noexcept -> reference {
+      return static_cast<reference>(*coroutine_.promise().value_);
+    }
+    void increment() {
+      coroutine_.resume();
+      coroutine_.promise().rethrow();
+    }
+    [[nodiscard]] auto equals(std::default_sentinel_t /*unused*/) const noexcept -> bool {
+      return !coroutine_ || coroutine_.done();
+    }
+
+   private:
+    std::coroutine_handle<promise_type> coroutine_{};
+  };
+
+  generator() noexcept = default;
+  generator(generator const&) = delete;
+  generator(generator&& other) noexcept : coroutine_(std::exchange(other.coroutine_, nullptr)) {}
+  auto operator=(generator const&) -> generator& = delete;
+  auto operator=(generator&& other) noexcept -> generator& {
+    std::swap(coroutine_, other.coroutine_);
+    return *this;
+  }
+  ~generator() {
+    if (coroutine_) coroutine_.destroy();
+  }
+
+  /**
+   * @brief Run the coroutine to its first <code>co_yield</code>, may only be called once
+   *
+   * A default constructed or moved-from generator is empty, its <code>begin()</code> equals <code>end()</code>.
+   */
+  [[nodiscard]] auto begin() -> iterator {
+    iterator first(coroutine_);
+    if (coroutine_) first.increment();
+    return first;
+  }
+
+  [[nodiscard]] static auto end() noexcept -> std::default_sentinel_t { return {}; }
+
+ private:
+  std::coroutine_handle<promise_type> coroutine_{};
+
+  explicit generator(std::coroutine_handle<promise_type> coroutine) noexcept : coroutine_(coroutine) {}
+};
+
+/// \ref generator which recycles its frames through the thread local \ref frame_pool
+template <class T>
+using pooled_generator = generator<T, recycling_allocator<std::byte>>;
+
+/** @} */  // end of generator
+
+}  // namespace ITERATOR_FACADE_NS
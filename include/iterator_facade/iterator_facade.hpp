@@ -11,8 +11,25 @@
 
 #include <concepts>
 #include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <type_traits>
 
+#ifdef ITERF_INSTRUMENT
+#  include <array>
+#  include <atomic>
+#  include <cstddef>
+#  include <cstdint>
+#  include <deque>
+#  include <mutex>
+#  include <ostream>
+#  include <source_location>
+#  include <string_view>
+#  include <vector>
+#endif
+
 #if defined(_MSC_VER)
 #  define ITERF_ALWAYS_INLINE __forceinline
 #elif defined(__GNUC__) || defined(__clang__)
@@ -25,9 +42,142 @@
 #  define ITERATOR_FACADE_NS iterator_facade
 #endif
 
+#ifdef ITERF_INSTRUMENT
+/// Count a call of the <code>Op</code> hook of the facade iterator <code>Iter</code>
+#  define ITERF_COUNT(Iter, Op)                        \
+    ::ITERATOR_FACADE_NS::_ifacade_detail::count<Iter>( \
+        ::ITERATOR_FACADE_NS::instrumentation::operation::Op)
+#else
+#  define ITERF_COUNT(Iter, Op) static_cast<void>(0)
+#endif
+
 // https://vector-of-bool.github.io/2020/06/13/cpp20-iter-facade.html
 namespace ITERATOR_FACADE_NS {
 
+#ifdef ITERF_INSTRUMENT
+
+/** @defgroup instrumentation Instrumentation
+ *  Defining <code>ITERF_INSTRUMENT</code> before including the facade counts the calls of every hook per iterator type,
+ *  without it the counting compiles to nothing. Calls during constant evaluation are not counted. The macro has to be
+ *  defined consistently in every translation unit of a program.
+ *  @{
+ */
+namespace instrumentation {
+
+/// Counted hooks, <code>retreat</code> is counted as <code>advance</code>
+enum class operation : std::size_t { dereference, increment, decrement, advance, distance_to, equals };
+
+inline constexpr std::size_t operation_count = 6;
+
+[[nodiscard]] constexpr auto name(operation op) noexcept -> std::string_view {
+  constexpr std::array<std::string_view, operation_count> names{"dereference", "increment",   "decrement",
+                                                                "advance",     "distance_to", "equals"};
+  return names[static_cast<std::size_t>(op)];
+}
+
+/// Call counters of one iterator type, incremented concurrently with relaxed atomics
+struct type_counters {
+  explicit type_counters(std::string_view type_name) noexcept : type(type_name) {}
+
+  std::string_view type;
+  std::array<std::atomic<std::uint64_t>, operation_count> calls{};
+};
+
+/// Copy of the counters of one iterator type
+struct operation_counts {
+  std::string_view type;
+  std::array<std::uint64_t, operation_count> calls{};
+
+  [[nodiscard]] constexpr auto operator[](operation op) const noexcept -> std::uint64_t {
+    return calls[static_cast<std::size_t>(op)];
+  }
+};
+
+/**
+ * @brief Human readable name of <code>T</code>, extracted from the name of this function where the compiler supports it
+ */
+template <class T>
+[[nodiscard]] auto type_name() noexcept -> std::string_view {
+  std::string_view name = std::source_location::current().function_name();
+  // "auto type_name() [with T = foo; ...]" (GCC) or "auto type_name() [T = foo]" (Clang)
+  if (auto const first = name.find("T = "); first != std::string_view::npos) {
+    name.remove_prefix(first + 4);
+    name = name.substr(0, name.find_first_of(";]"));
+  }
+  return name;
+}
+
+/**
+ * @brief Process wide list of the counters of every instrumented iterator type which has been used
+ */
+class registry {
+ public:
+  [[nodiscard]] static auto instance() -> registry& {
+    static registry counters;
+    return counters;
+  }
+
+  /**
+   * @brief Add counters for a type, called once per type on its first counted operation
+   */
+  auto add(std::string_view type) -> type_counters& {
+    std::scoped_lock const lock(mutex_);
+    return entries_.emplace_back(type);
+  }
+
+  /**
+   * @brief Counts of every registered type in order of first use
+   */
+  [[nodiscard]] auto snapshot() const -> std::vector<operation_counts> {
+    std::scoped_lock const lock(mutex_);
+    std::vector<operation_counts> result;
+    result.reserve(entries_.size());
+    for (auto const& entry : entries_) {
+      auto& counts = result.emplace_back(operation_counts{.type = entry.type});
+      for (std::size_t op = 0; op < operation_count; ++op) {
+        counts.calls[op] = entry.calls[op].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Set all counters to zero, the types stay registered
+   */
+  void reset() noexcept {
+    std::scoped_lock const lock(mutex_);
+    for (auto& entry : entries_) {
+      for (auto& calls : entry.calls) calls.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Write one line per type with the counts of all operations
+   */
+  void dump(std::ostream& out) const {
+    for (auto const& counts : snapshot()) {
+      out << counts.type << ':';
+      for (std::size_t op = 0; op < operation_count; ++op) {
+        out << ' ' << name(static_cast<operation>(op)) << '=' << counts.calls[op];
+      }
+      out << '\n';
+    }
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  // deque never relocates its elements, the counters are referenced by the iterators
+  std::deque<type_counters> entries_;
+
+  registry() = default;
+};
+
+}  // namespace instrumentation
+
+/** @} */  // end of instrumentation
+
+#endif
+
 namespace _ifacade_detail {
 
 /// \brief Wrapper for rvalue return values when expecting an lvalue address
@@ -57,9 +207,42 @@ template <typename T>
 struct inferred_value_type<T> {
   using type = typename T::value_type;
 };
+template <typename T>
+  requires(!requires { typename T::value_type; } &&
+           requires { typename std::remove_cvref_t<decltype(*std::declval<T&>())>::proxy_value_type; })
+struct inferred_value_type<T> {
+  using type = typename std::remove_cvref_t<decltype(*std::declval<T&>())>::proxy_value_type;
+};
 template <typename T>
 using inferred_value_type_t = typename inferred_value_type<T>::type;
 
+template <typename T>
+struct inferred_reference {
+  using type = decltype(*std::declval<T&>());
+};
+template <typename T>
+  requires requires { typename T::reference; }
+struct inferred_reference<T> {
+  using type = typename T::reference;
+};
+template <typename T>
+using inferred_reference_t = typename inferred_reference<T>::type;
+
+#ifdef ITERF_INSTRUMENT
+template <class T>
+[[nodiscard]] auto counters_of() -> instrumentation::type_counters& {
+  static instrumentation::type_counters& counters =
+      instrumentation::registry::instance().add(instrumentation::type_name<T>());
+  return counters;
+}
+
+template <class T>
+ITERF_ALWAYS_INLINE constexpr void count(instrumentation::operation op) noexcept {
+  if (std::is_constant_evaluated()) return;
+  counters_of<T>().calls[static_cast<std::size_t>(op)].fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
 // clang-format off
 
 // Check for .increment
@@ -114,6 +297,21 @@ concept has_nothrow_advance = requires(T& it, Diff offset) {
   { it.advance(offset) } noexcept;
 };
 
+// Check for .retreat
+template <typename T, class Diff = inferred_difference_type_t<T>>
+concept has_retreat = requires(T& it, Diff offset) {
+  it.retreat(offset);
+};
+template <typename T, class Diff = inferred_difference_type_t<T>>
+concept has_nothrow_retreat = requires(T& it, Diff offset) {
+  { it.retreat(offset) } noexcept;
+};
+
+// retreat(n) is preferred over advance(-n) for backward jumps
+template <typename T, class Diff = inferred_difference_type_t<T>>
+concept has_nothrow_backward = (has_retreat<T, Diff> && has_nothrow_retreat<T, Diff>) ||
+                               (!has_retreat<T, Diff> && has_nothrow_advance<T, Diff>);
+
 // Check for equals
 template <typename T, typename It = T>
 concept equality_comparable = requires(const T& sentinel, const It& it) {
@@ -138,14 +336,24 @@ concept dereferences_lvalue = requires (T const& it) {
   { it.dereference() } -> lvalue_reference;
 };
 
+// Check for .to_address, the address of the current element makes an iterator contiguous
+template <class T>
+concept has_to_address = dereferences_lvalue<T> && requires(T const& it) {
+  { it.to_address() } -> std::same_as<decltype(std::addressof(it.dereference()))>;
+};
+template <class T>
+concept has_nothrow_to_address = requires(T const& it) {
+  { it.to_address() } noexcept;
+};
+
 // We can meet "random access" if it provides
 // both .advance() and .distance_to()
 template <typename T>
 concept meets_random_access = has_advance<T> && has_distance_to<T>;
 
-// We meet `bidirectional` if we are random_access, OR we have .decrement()
+// We meet `bidirectional` if we are random_access, OR we have .decrement() or .retreat()
 template <typename T>
-concept meets_bidirectional = meets_random_access<T> || has_decrement<T>;
+concept meets_bidirectional = meets_random_access<T> || has_decrement<T> || has_retreat<T>;
 
 template <typename T>
 concept decls_contiguous = requires {
@@ -162,6 +370,68 @@ template <class T>
 concept incrementable = has_increment<T> || has_advance<T> || requires(T& it) {
   { ++it } -> std::common_reference_with<std::remove_cvref_t<T>>;
 };
+
+// Check for .iter_move
+template <class T>
+concept has_iter_move = requires(T const& it) {
+  it.iter_move();
+};
+template <class T>
+concept has_nothrow_iter_move = requires(T const& it) {
+  { it.iter_move() } noexcept;
+};
+
+// Check for .iter_swap
+template <class T, class Other = T>
+concept has_iter_swap = requires(T const& it, Other const& other) {
+  it.iter_swap(other);
+};
+template <class T, class Other = T>
+concept has_nothrow_iter_swap = requires(T const& it, Other const& other) {
+  { it.iter_swap(other) } noexcept;
+};
+
+// Check for the segmented iterator protocol: .segment(), .local(), .segment_begin(), .segment_end() and .compose()
+template <class T>
+concept has_segments = requires(T const& it) {
+  { it.segment() } -> std::forward_iterator;
+  { it.local() } -> std::forward_iterator;
+} && requires(T const& it, decltype(it.segment()) segment, decltype(it.local()) local) {
+  { it.segment_begin(segment) } -> std::same_as<decltype(it.local())>;
+  { it.segment_end(segment) } -> std::same_as<decltype(it.local())>;
+  { it.compose(segment, local) } -> std::same_as<T>;
+};
+
+// Check for .next_block(n) returning a contiguous block of values
+template <class T>
+concept has_next_block = requires(T& it, inferred_difference_type_t<T> n) {
+  { it.next_block(n) } -> std::ranges::contiguous_range;
+};
+
+// Check for .dereference
+template <class T>
+concept has_dereference = requires(T const& it) {
+  it.dereference();
+};
+
+// Output iterators implement .write(value) instead of .dereference(), write cannot be checked without a value type
+template <class T>
+concept output_only = !has_dereference<T>;
+
+template <class T, class Value>
+concept has_write = requires(T& it, Value&& value) {
+  it.write(std::forward<Value>(value));
+};
+template <class T, class Value>
+concept has_nothrow_write = requires(T& it, Value&& value) {
+  { it.write(std::forward<Value>(value)) } noexcept;
+};
+
+// Check for .write_n(values) accepting a contiguous batch of values
+template <class T, class Value>
+concept has_write_n = requires(T& it, std::span<Value const> values) {
+  it.write_n(values);
+};
 // clang-format on
 
 template <class Iter>
@@ -182,12 +452,66 @@ using iterator_category_t =
 
 // contiguous_iterator is a special case of random_access and output iterator is deduced by STL
 template <class T>
-concept satisfies_contiguous = meets_random_access<T> && decls_contiguous<T> && dereferences_lvalue<T>;
+concept satisfies_contiguous = meets_random_access<T> && dereferences_lvalue<T> &&
+                               (decls_contiguous<T> || has_to_address<T>);
 
 template <class Iter>
 using iterator_concept_t =
     std::conditional_t<satisfies_contiguous<Iter>, std::contiguous_iterator_tag, iterator_category_t<Iter>>;
 
+// single pass iterators cannot return a copy of themselves from postfix increment
+template <class T>
+concept single_pass = std::same_as<iterator_category_t<T>, std::input_iterator_tag> && !output_only<T>;
+
+// clang-format off
+template <class T>
+concept postfix_proxyable = requires(T const& it) {
+  inferred_value_type_t<T>(*it);
+} && std::move_constructible<inferred_value_type_t<T>>;
+// clang-format on
+
+/// \brief Return value of postfix increment of single pass iterators which holds the value at the previous position
+template <class T>
+class postfix_proxy {
+ public:
+  template <class U>
+  constexpr explicit postfix_proxy(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>)
+      : value_(std::forward<U>(value)) {}
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator*() noexcept -> T& { return value_; }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator*() const noexcept -> T const& { return value_; }
+
+ private:
+  T value_;
+};
+
+/// \brief Return value of <code>operator*</code> of output iterators, assigning a value to it writes the value
+template <class Iter>
+class output_proxy {
+ public:
+  constexpr explicit output_proxy(Iter& it) noexcept : it_(std::addressof(it)) {}
+
+  // const so that std::indirectly_writable is satisfied
+  template <class Value>
+    requires(has_write<Iter, Value>)
+  ITERF_ALWAYS_INLINE constexpr auto operator=(Value&& value) const noexcept(has_nothrow_write<Iter, Value>)
+      -> output_proxy const& {
+    it_->write(std::forward<Value>(value));
+    return *this;
+  }
+
+ private:
+  Iter* it_;
+};
+
+/// \brief Storage for the last dereferenced value of a memoizing iterator, empty otherwise
+template <class Derived, class T>
+struct dereference_cache {
+  mutable std::optional<T> cached_value_;
+};
+template <class Derived>
+struct dereference_cache<Derived, void> {};
+
 template <class T>
 [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto arrow_helper(T& t) noexcept -> T& {
   return t;
@@ -222,15 +546,58 @@ template <class T>
  *    Random access: <br>
  *    *   <code>auto distance_to(T|sized_sentinel) const -> difference_type </code> (can replace equal) <br>
  *    *   <code>void advance(difference_type) </code> (can replace increment/decrement) <br>
+ *    *   <code>void retreat(difference_type) </code> (optional) moves back by n, preferred over
+ *        <code>advance(-n)</code> for backward jumps <br>
+ *
+ *    Output iterator (instead of <code>dereference</code>): <br>
+ *    *   <code>void write(value) </code> writes a value at the current position, called by <code>*it = value</code> <br>
+ *    *   <code>void write_n(std::span<value const>) </code> (optional) writes a batch of values as if by calling
+ *        <code>write</code> for each, used by <code>copy</code> and <code>transform</code> in <code>algorithm.hpp</code> <br>
+ *    *   <code>void increment() </code> (optional) operator++ does nothing without it <br>
+ *
+ *    Contiguous (optional, random access iterators dereferencing to lvalues): <br>
+ *    *   <code>auto to_address() const -> element_type* </code> address of the current element, makes the iterator
+ *        a <code>std::contiguous_iterator</code> without setting <code>Contiguous</code> and is returned from
+ *        <code>operator-></code> and <code>std::to_address</code> <br>
+ *    *   <code>static auto pointer_to(element_type&) -> Derived </code> (optional) exported as
+ *        <code>std::pointer_traits<Derived>::pointer_to</code> <br>
  *
- * @tparam Contiguous true if the derived iterator is contiguous, otherwise false since it cannot be inferred
+ *    Customization points (optional, exported as <code>iter_move</code> and <code>iter_swap</code> for ADL): <br>
+ *    *   <code>auto iter_move() const -> rvalue_reference </code> <br>
+ *    *   <code>void iter_swap(T) const </code> swaps the pointed to values <br>
+ *
+ *    Segmented (optional, used by the algorithms in <code>algorithm.hpp</code>): <br>
+ *    *   <code>auto segment() const -> segment_iterator </code> <br>
+ *    *   <code>auto local() const -> local_iterator </code> <br>
+ *    *   <code>auto segment_begin(segment_iterator) const -> local_iterator </code> (may be static) <br>
+ *    *   <code>auto segment_end(segment_iterator) const -> local_iterator </code> (may be static) <br>
+ *    *   <code>auto compose(segment_iterator, local_iterator) const -> Derived </code> (may be static) <br>
+ *
+ *    Block (optional, used by the algorithms in <code>algorithm.hpp</code>): <br>
+ *    *   <code>auto next_block(difference_type n) -> contiguous_range </code> returns up to n values starting at the
+ *        current position and advances past them, the block is empty only at the end of the sequence <br>
+ *
+ * @tparam Contiguous true if the derived iterator is contiguous, otherwise false since it cannot be inferred unless
+ * <code>Derived::to_address()</code> is implemented
+ * @tparam CachedValue type returned by value from <code>dereference()</code> to memoize it, otherwise void. The last
+ * dereferenced value is stored in the iterator and returned (by value) from <code>operator*</code> until the iterator
+ * is moved by any of the operators, so repeated dereferences at one position call <code>dereference()</code> once.
+ * Hooks called directly, e.g. <code>next_block(n)</code>, do not invalidate the cache. <code>operator*</code> returns a
+ * copy of <code>CachedValue</code> on every call and <code>operator-></code> an arrow proxy holding one, since a
+ * reference into the iterator would dangle when a copy of the iterator is advanced or destroyed, e.g. the temporary in
+ * <code>std::reverse_iterator::operator-></code>, and break the multipass guarantee of forward iterators. The cache is
+ * written by the <code>const</code> <code>operator*</code>, so unlike standard library types a memoizing iterator must
+ * not be dereferenced from several threads at once, every thread has to use its own copy.
  */
-template <typename Derived, bool Contiguous = false>
-class iterator_facade {
+template <typename Derived, bool Contiguous = false, class CachedValue = void>
+class iterator_facade : private _ifacade_detail::dereference_cache<Derived, CachedValue> {
  public:
   using self_type = Derived;
 
   constexpr static bool contiguous_iterator = Contiguous;
+  constexpr static bool memoized = !std::is_void_v<CachedValue>;
+
+  static_assert(!(Contiguous && memoized), "contiguous iterators dereference to lvalues which need no memoization");
 
   // cannot add any type aliases as Derived is incomplete at this point, can only rely on decltype(auto) in declarations
 
@@ -243,6 +610,21 @@ class iterator_facade {
     return static_cast<const self_type&>(*this);
   }
 
+  template <class T = CachedValue>
+    requires(memoized)
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto cached_value() const
+      noexcept(_ifacade_detail::has_nothrow_dereference<self_type>&& std::is_nothrow_move_constructible_v<T>) -> T& {
+    if (!this->cached_value_) {
+      ITERF_COUNT(self_type, dereference);
+      this->cached_value_.emplace(self().dereference());
+    }
+    return *this->cached_value_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void invalidate() noexcept {
+    if constexpr (memoized) this->cached_value_.reset();
+  }
+
  public:
   /** @defgroup dereference Dereferencing
    *  Requires <code>Derived::dereference() const</code>
@@ -255,19 +637,50 @@ class iterator_facade {
    * @return decltype(Derived{}.dereference())
    */
   [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator*() const
-      noexcept(_ifacade_detail::has_nothrow_dereference<self_type>) -> decltype(auto) {
+      noexcept(_ifacade_detail::has_nothrow_dereference<self_type>) -> decltype(auto)
+    requires(!memoized && !_ifacade_detail::output_only<self_type>)
+  {
+    ITERF_COUNT(self_type, dereference);
     return self().dereference();
   }
 
+  /**
+   * @brief Dereference operator of output iterators
+   *
+   * @return proxy which calls <code>Derived::write(value)</code> when a value is assigned to it
+   */
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator*() noexcept -> _ifacade_detail::output_proxy<self_type>
+    requires(_ifacade_detail::output_only<self_type>)
+  {
+    return _ifacade_detail::output_proxy<self_type>(self());
+  }
+
+  /**
+   * @brief Dereference operator of memoizing iterators
+   *
+   * @return copy of the cached return value of <code>Derived::dereference() const</code>
+   */
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator*() const
+      noexcept(noexcept(cached_value()) && std::is_nothrow_copy_constructible_v<CachedValue>) -> CachedValue
+    requires(memoized)
+  {
+    return cached_value();
+  }
+
   /**
    * @brief Arrow operator
    *
-   * @return Pointer or arrow proxy to the return value of <code>Derived::dereference() const</code>
+   * @return <code>Derived::to_address() const</code> if available, otherwise pointer or arrow proxy to the return value
+   * of <code>Derived::dereference() const</code>
    */
-  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto
-  operator->() const noexcept((_ifacade_detail::has_nothrow_dereference<self_type> && noexcept(_ifacade_detail::arrow_helper(**this))))
-      -> decltype(auto) {
-    if constexpr (_ifacade_detail::dereferences_lvalue<self_type>) {
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator->() const
+      noexcept(_ifacade_detail::has_to_address<self_type>
+                   ? _ifacade_detail::has_nothrow_to_address<self_type>
+                   : (_ifacade_detail::has_nothrow_dereference<self_type> &&
+                      noexcept(_ifacade_detail::arrow_helper(**this)))) -> decltype(auto) {
+    if constexpr (_ifacade_detail::has_to_address<self_type>) {
+      return self().to_address();
+    } else if constexpr (_ifacade_detail::dereferences_lvalue<self_type>) {
       return std::addressof(**this);
     } else {
       return _ifacade_detail::arrow_helper(**this);
@@ -293,6 +706,7 @@ class iterator_facade {
   template <_ifacade_detail::equality_comparable<self_type> T>
   [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto friend operator==(self_type const& lhs, T const& rhs) noexcept(
       _ifacade_detail::nothrow_equality_comparable<T, self_type>) -> bool {
+    ITERF_COUNT(self_type, equals);
     return lhs.equals(rhs);
   }
 
@@ -312,6 +726,7 @@ class iterator_facade {
 #endif
   [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto friend operator==(self_type const& lhs, T const& rhs) noexcept(
       _ifacade_detail::has_nothrow_distance_to<T, self_type>) -> bool {
+    ITERF_COUNT(self_type, distance_to);
     return lhs.distance_to(rhs) == 0;
   }
 
@@ -331,7 +746,9 @@ class iterator_facade {
     requires(_ifacade_detail::has_increment<T>)
   ITERF_ALWAYS_INLINE constexpr auto operator++() noexcept(_ifacade_detail::has_nothrow_increment<self_type>)
       -> self_type& {
+    ITERF_COUNT(self_type, increment);
     self().increment();
+    invalidate();
     return self();
   }
 
@@ -345,17 +762,46 @@ class iterator_facade {
     requires(!_ifacade_detail::has_increment<T> && _ifacade_detail::has_advance<T, int>)
   ITERF_ALWAYS_INLINE constexpr auto operator++() noexcept(_ifacade_detail::has_nothrow_advance<self_type, int>)
       -> self_type& {
+    ITERF_COUNT(self_type, advance);
     self().advance(1);
+    invalidate();
     return self();
   }
 
   /**
-   * @brief Post-increment operator, requires <code>Derived::increment()</code> or <code>Derived::advance(1)</code>
+   * @brief Pre-increment operator of output iterators without <code>Derived::increment()</code>, e.g. appending
+   * iterators, does nothing
    *
    * @return Derived&
    */
   template <class T = self_type>
-    requires(_ifacade_detail::has_increment<T> || _ifacade_detail::has_advance<T, int>)
+    requires(_ifacade_detail::output_only<T> && !_ifacade_detail::has_increment<T> &&
+             !_ifacade_detail::has_advance<T, int>)
+  ITERF_ALWAYS_INLINE constexpr auto operator++() noexcept -> self_type& {
+    return self();
+  }
+
+  /**
+   * @brief Post-increment operator of output iterators without <code>Derived::increment()</code>, does nothing
+   *
+   * @return Derived& so that move-only output iterators support <code>*it++ = value</code>
+   */
+  template <class T = self_type>
+    requires(_ifacade_detail::output_only<T> && !_ifacade_detail::has_increment<T> &&
+             !_ifacade_detail::has_advance<T, int>)
+  ITERF_ALWAYS_INLINE constexpr auto operator++(int) noexcept -> self_type& {
+    return self();
+  }
+
+  /**
+   * @brief Post-increment operator of forward and output iterators, requires <code>Derived::increment()</code> or
+   * <code>Derived::advance(1)</code>
+   *
+   * @return copy of Derived before incrementing
+   */
+  template <class T = self_type>
+    requires((_ifacade_detail::has_increment<T> || _ifacade_detail::has_advance<T, int>) &&
+             !_ifacade_detail::single_pass<T>)
   [[nodiscard]] constexpr auto operator++(int) noexcept(
       std::is_nothrow_copy_constructible_v<self_type>&& noexcept(++(*this))) -> self_type {
     auto copy = self();
@@ -363,6 +809,32 @@ class iterator_facade {
     return copy;
   }
 
+  /**
+   * @brief Post-increment operator of single pass (input) iterators, which does not copy the iterator
+   *
+   * @return proxy holding the value at the previous position so that <code>*it++</code> is valid
+   */
+  template <class T = self_type>
+    requires((_ifacade_detail::has_increment<T> || _ifacade_detail::has_advance<T, int>) &&
+             _ifacade_detail::single_pass<T> && _ifacade_detail::postfix_proxyable<T>)
+  [[nodiscard]] constexpr auto operator++(int) noexcept(
+      noexcept(_ifacade_detail::postfix_proxy<_ifacade_detail::inferred_value_type_t<T>>(**this)) &&
+      noexcept(++(*this))) -> _ifacade_detail::postfix_proxy<_ifacade_detail::inferred_value_type_t<T>> {
+    _ifacade_detail::postfix_proxy<_ifacade_detail::inferred_value_type_t<T>> previous(**this);
+    ++(*this);
+    return previous;
+  }
+
+  /**
+   * @brief Post-increment operator of single pass (input) iterators whose values cannot be stored
+   */
+  template <class T = self_type>
+    requires((_ifacade_detail::has_increment<T> || _ifacade_detail::has_advance<T, int>) &&
+             _ifacade_detail::single_pass<T> && !_ifacade_detail::postfix_proxyable<T>)
+  constexpr void operator++(int) noexcept(noexcept(++(*this))) {
+    ++(*this);
+  }
+
   /** @} */  // end of increment
 
   /** @defgroup decrement Decrement operators
@@ -379,80 +851,109 @@ class iterator_facade {
     requires(_ifacade_detail::has_decrement<T>)
   ITERF_ALWAYS_INLINE constexpr auto operator--() noexcept(_ifacade_detail::has_nothrow_decrement<self_type>)
       -> self_type& {
+    ITERF_COUNT(self_type, decrement);
     self().decrement();
+    invalidate();
     return self();
   }
 
   /**
    * @brief Fallback pre-decrement operator when <code>Derived::decrement()</code> is not available, requires
-   * <code>Derived::advance(-1)</code> to be valid
+   * <code>Derived::retreat(1)</code> or <code>Derived::advance(-1)</code> to be valid
    *
    * @return Derived&
    */
   template <class T = self_type>
-    requires(!_ifacade_detail::has_decrement<T> && _ifacade_detail::has_advance<T, int>)
-  ITERF_ALWAYS_INLINE constexpr auto operator--() noexcept(_ifacade_detail::has_nothrow_advance<self_type, int>)
+    requires(!_ifacade_detail::has_decrement<T> &&
+             (_ifacade_detail::has_retreat<T, int> || _ifacade_detail::has_advance<T, int>))
+  ITERF_ALWAYS_INLINE constexpr auto operator--() noexcept(_ifacade_detail::has_nothrow_backward<self_type, int>)
       -> self_type& {
-    self().advance(-1);
+    ITERF_COUNT(self_type, advance);
+    if constexpr (_ifacade_detail::has_retreat<T, int>) {
+      self().retreat(1);
+    } else {
+      self().advance(-1);
+    }
+    invalidate();
     return self();
   }
 
   /**
-   * @brief Post-decrement operator, requires <code>Derived::decrement()</code> or <code>Derived::advance(-1)</code>
+   * @brief Post-decrement operator, requires <code>Derived::decrement()</code>, <code>Derived::retreat(1)</code> or
+   * <code>Derived::advance(-1)</code>
    *
    * @return Derived&
    */
   template <class T = self_type>
-    requires(_ifacade_detail::has_decrement<T> || _ifacade_detail::has_advance<T, int>)
+    requires(_ifacade_detail::has_decrement<T> || _ifacade_detail::has_retreat<T, int> ||
+             _ifacade_detail::has_advance<T, int>)
   [[nodiscard]] constexpr auto operator--(int) noexcept(
       std::is_nothrow_copy_constructible_v<self_type>&& noexcept(--(*this))) -> self_type {
     auto copy = self();
-    ++(*this);
+    --(*this);
     return copy;
   }
 
   /** @} */  // end of decrement
 
   /** @defgroup operators Operators
-   *  Requires <code>Derived::advance(difference_type)</code>
+   *  Requires <code>Derived::advance(difference_type)</code>, backward jumps use <code>Derived::retreat(difference_type)
+   *  </code> when available. All operators work in place, the binary ones only copy their iterator argument.
    *  @{
    */
 
   template <_ifacade_detail::advance_type_arg<self_type> D>
   ITERF_ALWAYS_INLINE friend constexpr auto operator+=(self_type& self, D offset) noexcept(
       _ifacade_detail::has_nothrow_advance<self_type, D>) -> self_type& {
+    ITERF_COUNT(self_type, advance);
     self.advance(offset);
+    self.invalidate();
     return self;
   }
 
   template <_ifacade_detail::advance_type_arg<self_type> D>
-  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator+(self_type left, D off) noexcept(
-      _ifacade_detail::has_nothrow_advance<self_type, D>) -> self_type {
-    return left += off;
+  ITERF_ALWAYS_INLINE friend constexpr auto operator-=(self_type& self, D offset) noexcept(
+      _ifacade_detail::has_nothrow_backward<self_type, D>) -> self_type& {
+    ITERF_COUNT(self_type, advance);
+    if constexpr (_ifacade_detail::has_retreat<self_type, D>) {
+      self.retreat(offset);
+    } else {
+      self.advance(-offset);
+    }
+    self.invalidate();
+    return self;
   }
 
+  // the arguments are modified in place and returned by name so that they are moved, not copied, into the result
   template <_ifacade_detail::advance_type_arg<self_type> D>
-  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator+(D off, self_type right) noexcept(
-      _ifacade_detail::has_nothrow_advance<self_type, D>) -> self_type {
-    return right += off;
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator+(self_type left, D off) noexcept(
+      _ifacade_detail::has_nothrow_advance<self_type, D>&& std::is_nothrow_move_constructible_v<self_type>)
+      -> self_type {
+    left += off;
+    return left;
   }
 
   template <_ifacade_detail::advance_type_arg<self_type> D>
-  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator-(self_type left, D off) noexcept(
-      _ifacade_detail::has_nothrow_advance<self_type, D>) -> self_type {
-    return left + -off;
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator+(D off, self_type right) noexcept(
+      _ifacade_detail::has_nothrow_advance<self_type, D>&& std::is_nothrow_move_constructible_v<self_type>)
+      -> self_type {
+    right += off;
+    return right;
   }
 
   template <_ifacade_detail::advance_type_arg<self_type> D>
-  ITERF_ALWAYS_INLINE friend constexpr auto operator-=(self_type& left, D off) noexcept(
-      _ifacade_detail::has_nothrow_advance<self_type, D>) -> self_type& {
-    return left = left - off;
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator-(self_type left, D off) noexcept(
+      _ifacade_detail::has_nothrow_backward<self_type, D>&& std::is_nothrow_move_constructible_v<self_type>)
+      -> self_type {
+    left -= off;
+    return left;
   }
 
   template <class T = self_type, _ifacade_detail::advance_type_arg<T> D>
   [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto operator[](D off) const
       noexcept(_ifacade_detail::has_nothrow_advance<self_type, D>&& _ifacade_detail::has_nothrow_dereference<self_type>)
           -> decltype(auto) {
+    ITERF_COUNT(self_type, dereference);
     return (self() + off).dereference();
   }
 
@@ -475,6 +976,7 @@ class iterator_facade {
   [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator-(const T& left, self_type const& right) noexcept(
       _ifacade_detail::has_nothrow_distance_to<T, self_type>) -> decltype(auto) {
     // Many many times must we `++right` to reach `left` ?
+    ITERF_COUNT(self_type, distance_to);
     return right.distance_to(left);
   }
 
@@ -507,10 +1009,82 @@ class iterator_facade {
   [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator<=>(
       const self_type& left,
       const Sentinel& right) noexcept(_ifacade_detail::has_nothrow_distance_to<Sentinel, self_type>) {
-    return -left.distance_to(right) <=> 0;
+    // compared without negating the distance, which could overflow
+    ITERF_COUNT(self_type, distance_to);
+    return 0 <=> left.distance_to(right);
+  }
+
+  // the relational operators test the sign of the distance directly, going through the std::strong_ordering of <=>
+  // costs a second comparison against zero when it is inlined
+
+  template <_ifacade_detail::has_distance_to<self_type> Sentinel>
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator<(
+      const self_type& left,
+      const Sentinel& right) noexcept(_ifacade_detail::has_nothrow_distance_to<Sentinel, self_type>) -> bool {
+    ITERF_COUNT(self_type, distance_to);
+    return left.distance_to(right) > 0;
+  }
+
+  template <_ifacade_detail::has_distance_to<self_type> Sentinel>
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator>(
+      const self_type& left,
+      const Sentinel& right) noexcept(_ifacade_detail::has_nothrow_distance_to<Sentinel, self_type>) -> bool {
+    ITERF_COUNT(self_type, distance_to);
+    return left.distance_to(right) < 0;
+  }
+
+  template <_ifacade_detail::has_distance_to<self_type> Sentinel>
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator<=(
+      const self_type& left,
+      const Sentinel& right) noexcept(_ifacade_detail::has_nothrow_distance_to<Sentinel, self_type>) -> bool {
+    ITERF_COUNT(self_type, distance_to);
+    return left.distance_to(right) >= 0;
+  }
+
+  template <_ifacade_detail::has_distance_to<self_type> Sentinel>
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto operator>=(
+      const self_type& left,
+      const Sentinel& right) noexcept(_ifacade_detail::has_nothrow_distance_to<Sentinel, self_type>) -> bool {
+    ITERF_COUNT(self_type, distance_to);
+    return left.distance_to(right) <= 0;
   }
 
   /** @} */  // end of comparison
+
+  /** @defgroup customization Customization points
+   *  Requires <code>Derived::iter_move() const</code> or <code>Derived::iter_swap(T) const</code>, used by
+   *  <code>std::ranges::iter_move</code> and <code>std::ranges::iter_swap</code>
+   *  @{
+   */
+
+  /**
+   * @brief Cast the pointed to value to an rvalue, requires <code>Derived::iter_move() const</code>
+   *
+   * @param it
+   * @return decltype(Derived{}.iter_move())
+   */
+  template <class T = self_type>
+    requires(_ifacade_detail::has_iter_move<T>)
+  [[nodiscard]] ITERF_ALWAYS_INLINE friend constexpr auto iter_move(self_type const& it) noexcept(
+      _ifacade_detail::has_nothrow_iter_move<T>) -> decltype(auto) {
+    return it.iter_move();
+  }
+
+  /**
+   * @brief Swap the pointed to values, requires <code>Derived::iter_swap(T) const</code>
+   *
+   * @tparam T other iterator type
+   * @param left
+   * @param right
+   */
+  template <class T>
+    requires(_ifacade_detail::has_iter_swap<self_type, T>)
+  ITERF_ALWAYS_INLINE friend constexpr void iter_swap(self_type const& left, T const& right) noexcept(
+      _ifacade_detail::has_nothrow_iter_swap<self_type, T>) {
+    left.iter_swap(right);
+  }
+
+  /** @} */  // end of customization
 };
 
 /** @} */  // end of facade
@@ -520,8 +1094,8 @@ namespace _ifacade_detail {
 template <class Derived>
 struct is_base_of_facade {
  private:
-  template <class T, bool B>
-  static auto derives(iterator_facade<T, B> const&) -> std::true_type;
+  template <class T, bool B, class V>
+  static auto derives(iterator_facade<T, B, V> const&) -> std::true_type;
   static auto derives(...) -> std::false_type;
 
  public:
@@ -537,6 +1111,72 @@ struct is_base_of_facade {
 template <class T>
 concept iterator_facade_subclass = _ifacade_detail::is_base_of_facade<T>::value;
 
+/**
+ * @brief Check if iterator exposes the segmented iterator protocol, i.e. it iterates over a sequence of segments
+ * (chunks) which can be traversed with local iterators without checking for the end of a segment on every step
+ *
+ * The end iterator of a segmented range must point to the end of the last segment (not to the beginning of a
+ * non-existent next segment) so that <code>segment_begin(end.segment())</code> is valid.
+ *
+ * @tparam T type to check
+ */
+template <class T>
+concept segmented_iterator = std::forward_iterator<T> && _ifacade_detail::has_segments<T>;
+
+/**
+ * @brief Iterator over the segments of a \ref segmented_iterator
+ */
+template <segmented_iterator T>
+using segment_iterator_t = decltype(std::declval<T const&>().segment());
+
+/**
+ * @brief Iterator within a single segment of a \ref segmented_iterator
+ */
+template <segmented_iterator T>
+using local_iterator_t = decltype(std::declval<T const&>().local());
+
+/**
+ * @brief Check if iterator can deliver values a block at a time with <code>next_block(n)</code>
+ *
+ * A block never extends past the end of the underlying sequence, consumers are responsible for not requesting more
+ * values than they need.
+ *
+ * @tparam T type to check
+ */
+template <class T>
+concept block_iterator = std::input_iterator<T> && _ifacade_detail::has_next_block<T>;
+
+/**
+ * @brief Check if output iterator accepts contiguous batches of values with <code>write_n(values)</code>
+ *
+ * @tparam T type to check
+ * @tparam Value type of the written values
+ */
+template <class T, class Value>
+concept bulk_output_iterator = std::output_iterator<T, Value const&> && _ifacade_detail::has_write_n<T, Value>;
+
+/**
+ * @brief Check if type is a proxy reference, i.e. it declares the type it stands in for as
+ * <code>using proxy_value_type = V</code> and is convertible to it
+ *
+ * <code>std::basic_common_reference</code> is specialized for every proxy reference and its value type so that
+ * iterators dereferencing to a proxy (zip and bit iterators) satisfy <code>std::indirectly_readable</code>. The common
+ * reference of a proxy and its value type is the value type. Proxies should also provide <code>const</code> assignment
+ * from the value type to satisfy <code>std::indirectly_writable</code> and a <code>swap</code> overload taking proxies
+ * by value to be swappable.
+ *
+ * @tparam T type to check
+ */
+template <class T>
+concept proxy_reference = requires {
+  typename T::proxy_value_type;
+} && std::convertible_to<T const&, typename T::proxy_value_type>;
+
+namespace _ifacade_detail {
+template <class Proxy, class Value>
+concept proxy_reference_of = proxy_reference<Proxy> && std::same_as<typename Proxy::proxy_value_type, Value>;
+}  // namespace _ifacade_detail
+
 // clang-format off
 template <class T>
 concept nothrow_dereference = std::input_or_output_iterator<T> && requires(T iter) {
@@ -599,7 +1239,7 @@ namespace _ifacade_detail {
 
 template <ITERATOR_FACADE_NS ::iterator_facade_subclass Iter>
 struct std::iterator_traits<Iter> {
-  using reference = decltype(*std::declval<Iter&>());
+  using reference = ITERATOR_FACADE_NS ::_ifacade_detail::inferred_reference_t<Iter>;
   using pointer = decltype(std::declval<Iter&>().operator->());
   using difference_type = ITERATOR_FACADE_NS ::_ifacade_detail::inferred_difference_type_t<Iter>;
   using value_type = ITERATOR_FACADE_NS ::_ifacade_detail::inferred_value_type_t<Iter>;
@@ -608,6 +1248,19 @@ struct std::iterator_traits<Iter> {
   using iterator_concept = ITERATOR_FACADE_NS ::_ifacade_detail::iterator_concept_t<Iter>;
 };
 
+// output iterators have no values to expose
+template <ITERATOR_FACADE_NS ::iterator_facade_subclass Iter>
+  requires(ITERATOR_FACADE_NS::_ifacade_detail::output_only<Iter>)
+struct std::iterator_traits<Iter> {
+  using reference = void;
+  using pointer = void;
+  using difference_type = ITERATOR_FACADE_NS ::_ifacade_detail::inferred_difference_type_t<Iter>;
+  using value_type = void;
+
+  using iterator_category = std::output_iterator_tag;
+  using iterator_concept = std::output_iterator_tag;
+};
+
 // specialization for contiguous iterators since the standard ends in compile error if Iter is not a template
 template <ITERATOR_FACADE_NS ::iterator_facade_subclass Iter>
   requires(ITERATOR_FACADE_NS::_ifacade_detail::satisfies_contiguous<Iter>)
@@ -619,9 +1272,29 @@ struct std::pointer_traits<Iter> {
   template <class Other>
   using rebind = typename ITERATOR_FACADE_NS::_ifacade_detail::rebind_alias<Iter, Other>::type;
 
-  using reference = conditional_t<is_void_v<element_type>, char, element_type>&;
+  using reference = std::conditional_t<std::is_void_v<element_type>, char, element_type>&;
 
-  [[nodiscard]] static pointer pointer_to(reference value) noexcept(noexcept(Iter::pointer_to(value))) {
+  [[nodiscard]] static pointer pointer_to(reference value) noexcept(noexcept(Iter::pointer_to(value)))
+    requires requires { Iter::pointer_to(value); }
+  {
     return Iter::pointer_to(value);
   }
+
+  // used by std::to_address, so contiguous algorithms work on the raw pointers
+  [[nodiscard]] constexpr static auto to_address(pointer const& it) noexcept(noexcept(it.operator->())) {
+    return it.operator->();
+  }
+};
+
+// common reference of a proxy reference and its value type is the value type
+template <class Proxy, class Value, template <class> class ProxyQual, template <class> class ValueQual>
+  requires(ITERATOR_FACADE_NS::_ifacade_detail::proxy_reference_of<Proxy, Value>)
+struct std::basic_common_reference<Proxy, Value, ProxyQual, ValueQual> {
+  using type = Value;
+};
+
+template <class Value, class Proxy, template <class> class ValueQual, template <class> class ProxyQual>
+  requires(ITERATOR_FACADE_NS::_ifacade_detail::proxy_reference_of<Proxy, Value>)
+struct std::basic_common_reference<Value, Proxy, ValueQual, ProxyQual> {
+  using type = Value;
 };
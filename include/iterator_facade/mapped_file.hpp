@@ -0,0 +1,302 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#if __has_include(<sys/mman.h>)
+
+#  include <algorithm>
+#  include <cerrno>
+#  include <cstddef>
+#  include <cstdint>
+#  include <filesystem>
+#  include <functional>
+#  include <iterator>
+#  include <limits>
+#  include <ranges>
+#  include <span>
+#  include <stdexcept>
+#  include <string>
+#  include <system_error>
+#  include <type_traits>
+#  include <utility>
+#  include <vector>
+
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+
+#  include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+/** @defgroup mapped Memory mapped files
+ *  Iterators over records of read-only memory mapped files (POSIX only), so ranges algorithms run over binary files
+ *  in place instead of over a copy read into a <code>std::vector</code>. Pages are loaded on first access and can be
+ *  dropped by the kernel again, so only the touched part of a file is resident.
+ *  @{
+ */
+
+/// Expected access pattern of a mapped range, passed to <code>madvise</code>
+enum class access_pattern {
+  normal,      ///< MADV_NORMAL, default read ahead
+  sequential,  ///< MADV_SEQUENTIAL, aggressive read ahead and pages can be dropped soon after they are read
+  random,      ///< MADV_RANDOM, no read ahead, e.g. for binary searches
+  willneed,    ///< MADV_WILLNEED, start reading the range now
+};
+
+namespace _ifacade_detail {
+
+[[nodiscard]] inline auto madvise_flag(access_pattern pattern) noexcept -> int {
+  switch (pattern) {
+    case access_pattern::sequential:
+      return MADV_SEQUENTIAL;
+    case access_pattern::random:
+      return MADV_RANDOM;
+    case access_pattern::willneed:
+      return MADV_WILLNEED;
+    case access_pattern::normal:
+      break;
+  }
+  return MADV_NORMAL;
+}
+
+}  // namespace _ifacade_detail
+
+/**
+ * @brief Contiguous iterator over fixed size records of type <code>T</code> in a mapped file
+ *
+ * @tparam T trivially copyable record type
+ */
+template <class T>
+  requires(std::is_trivially_copyable_v<T>)
+class record_iterator : public iterator_facade<record_iterator<T>, true> {
+ public:
+  using difference_type = std::ptrdiff_t;
+
+  constexpr record_iterator() noexcept = default;
+  constexpr explicit record_iterator(T const* record) noexcept : record_(record) {}
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept -> T const& { return *record_; }
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept { record_ += n; }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(record_iterator const& other) const noexcept
+      -> difference_type {
+    return other.record_ - record_;
+  }
+
+ private:
+  T const* record_ = nullptr;
+};
+
+/**
+ * @brief Random access iterator over variable length records, dereferences to the bytes of a record
+ *
+ * Record <code>i</code> spans <code>[offsets[i], offsets[i + 1])</code> of the data, so n records need an index of
+ * n + 1 offsets, which can be stored next to the data or built with \ref build_offset_index.
+ */
+class indexed_record_iterator : public iterator_facade<indexed_record_iterator> {
+ public:
+  using difference_type = std::ptrdiff_t;
+
+  constexpr indexed_record_iterator() noexcept = default;
+  constexpr indexed_record_iterator(std::byte const* data, std::uint64_t const* offset) noexcept
+      : data_(data), offset_(offset) {}
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept -> std::span<std::byte const> {
+    return {data_ + offset_[0], data_ + offset_[1]};
+  }
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept { offset_ += n; }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(indexed_record_iterator const& other) const noexcept
+      -> difference_type {
+    return other.offset_ - offset_;
+  }
+
+  /**
+   * @brief Offset of the current record from the start of the data
+   */
+  [[nodiscard]] constexpr auto offset() const noexcept -> std::uint64_t { return *offset_; }
+
+ private:
+  std::byte const* data_ = nullptr;
+  std::uint64_t const* offset_ = nullptr;
+};
+
+/**
+ * @brief Build the offset index of variable length records for \ref indexed_record_iterator
+ *
+ * @param bytes records stored back to back
+ * @param record_size called with the bytes starting at a record and returns its size in bytes, e.g. its length prefix
+ * plus the prefix size or the position after its delimiter
+ * @return the offsets of all records followed by the end of the last one
+ */
+template <class Fn>
+  requires std::is_invocable_r_v<std::size_t, Fn&, std::span<std::byte const>>
+[[nodiscard]] auto build_offset_index(std::span<std::byte const> bytes, Fn record_size) -> std::vector<std::uint64_t> {
+  std::vector<std::uint64_t> offsets{0};
+  std::size_t offset = 0;
+  while (offset < bytes.size()) {
+    auto const size = static_cast<std::size_t>(std::invoke(record_size, bytes.subspan(offset)));
+    if (size == 0 || size > bytes.size() - offset) throw std::out_of_range("record exceeds the mapped data");
+    offset += size;
+    offsets.push_back(offset);
+  }
+  return offsets;
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file, closes the mapping on destruction
+ */
+class mapped_file {
+ public:
+  mapped_file() noexcept = default;
+
+  /**
+   * @brief Map the file at <code>path</code>
+   *
+   * @throws std::system_error if the file cannot be opened or mapped
+   */
+  explicit mapped_file(std::filesystem::path const& path) {
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + path.string());
+
+    struct ::stat status {};
+    if (::fstat(fd, &status) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    // mmap rejects empty mappings, an empty file is an empty range
+    if (size_ != 0) {
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+      }
+      data_ = static_cast<std::byte const*>(data);
+    }
+    // the mapping stays valid after closing the descriptor
+    ::close(fd);
+  }
+
+  mapped_file(mapped_file const&) = delete;
+  auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+  auto operator=(mapped_file&& other) noexcept -> mapped_file& {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  [[nodiscard]] auto data() const noexcept -> std::byte const* { return data_; }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  [[nodiscard]] auto bytes() const noexcept -> std::span<std::byte const> { return {data_, size_}; }
+
+  /**
+   * @brief Advise the kernel how <code>[offset, offset + length)</code> will be accessed, the range is widened to
+   * page boundaries
+   *
+   * @throws std::system_error if <code>madvise</code> fails
+   */
+  void advise(access_pattern pattern, std::size_t offset = 0,
+              std::size_t length = std::numeric_limits<std::size_t>::max()) const {
+    if (offset >= size_) return;
+    length = std::min(length, size_ - offset);
+
+    auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const first = offset / page * page;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    void* address = const_cast<std::byte*>(data_ + first);
+    if (::madvise(address, length + (offset - first), _ifacade_detail::madvise_flag(pattern)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "madvise");
+    }
+  }
+
+  /**
+   * @brief Typed view of <code>count</code> records of type <code>T</code> starting at byte <code>offset</code>, all
+   * remaining whole records by default
+   *
+   * @throws std::invalid_argument if <code>offset</code> is not aligned for <code>T</code>
+   * @throws std::out_of_range if the records exceed the file
+   */
+  template <class T>
+    requires(std::is_trivially_copyable_v<T>)
+  [[nodiscard]] auto as_span(std::size_t offset = 0, std::size_t count = std::dynamic_extent) const
+      -> std::span<T const> {
+    if (offset > size_) throw std::out_of_range("offset exceeds the mapped file");
+    if (count == std::dynamic_extent) count = (size_ - offset) / sizeof(T);
+    if (count > (size_ - offset) / sizeof(T)) throw std::out_of_range("records exceed the mapped file");
+    if (count == 0) return {};
+    if (offset % alignof(T) != 0) throw std::invalid_argument("records are not aligned");
+    // the mapping is page aligned and T is trivially copyable, so the bytes are valid objects of type T
+    return {reinterpret_cast<T const*>(data_ + offset), count};  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  /**
+   * @brief Contiguous range of fixed size records, see \ref as_span, and advise the kernel of the access pattern
+   *
+   * @return std::ranges::subrange<record_iterator<T>>
+   */
+  template <class T>
+    requires(std::is_trivially_copyable_v<T>)
+  [[nodiscard]] auto records(std::size_t offset = 0, std::size_t count = std::dynamic_extent,
+                             access_pattern pattern = access_pattern::sequential) const
+      -> std::ranges::subrange<record_iterator<T>> {
+    auto const span = as_span<T>(offset, count);
+    advise(pattern, offset, span.size_bytes());
+    return {record_iterator<T>(span.data()), record_iterator<T>(span.data() + span.size())};
+  }
+
+  /**
+   * @brief Random access range of variable length records in <code>[offset, size())</code> delimited by the
+   * offsets index relative to <code>offset</code>, see \ref indexed_record_iterator
+   *
+   * The index is checked once to be non-decreasing so a corrupt index stored next to the data cannot address bytes
+   * outside of the mapping.
+   *
+   * @throws std::out_of_range if the index is empty, decreasing or the records exceed the file
+   */
+  [[nodiscard]] auto records(std::span<std::uint64_t const> offsets, std::size_t offset = 0,
+                             access_pattern pattern = access_pattern::random) const
+      -> std::ranges::subrange<indexed_record_iterator> {
+    if (offsets.empty()) throw std::out_of_range("offset index needs at least one entry");
+    if (offset > size_ || offsets.back() > size_ - offset) throw std::out_of_range("records exceed the mapped file");
+    if (!std::ranges::is_sorted(offsets)) throw std::out_of_range("offset index is not sorted");
+    advise(pattern, offset, static_cast<std::size_t>(offsets.back()));
+    return {indexed_record_iterator(data_ + offset, offsets.data()),
+            indexed_record_iterator(data_ + offset, offsets.data() + (offsets.size() - 1))};
+  }
+
+ private:
+  std::byte const* data_ = nullptr;
+  std::size_t size_ = 0;
+
+  void unmap() noexcept {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    if (data_ != nullptr) ::munmap(const_cast<std::byte*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+};
+
+/** @} */  // end of mapped
+
+}  // namespace ITERATOR_FACADE_NS
+
+#endif
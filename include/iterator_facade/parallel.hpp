@@ -0,0 +1,292 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "algorithm.hpp"
+
+#ifndef ITERF_PARALLEL_TASKS_PER_THREAD
+/// Number of chunks a range is split into per thread, more chunks balance uneven work better
+#  define ITERF_PARALLEL_TASKS_PER_THREAD 4
+#endif
+
+namespace ITERATOR_FACADE_NS {
+
+/** @defgroup parallel Parallel algorithms
+ *  Algorithms which split random access ranges into chunks and run them on a \ref thread_pool. The calling thread
+ *  runs chunks as well and the first exception thrown by any chunk is rethrown once all chunks have finished.
+ *  @{
+ */
+
+/**
+ * @brief Fixed size pool of <code>std::jthread</code> workers with work stealing
+ *
+ * Every worker owns a task deque, it runs tasks from the front of its own deque and steals from the back of the
+ * others when it runs out.
+ */
+class thread_pool {
+ public:
+  /**
+   * @brief Start <code>workers</code> worker threads, the thread calling \ref run participates as well so a pool with
+   * no workers runs everything on the calling thread
+   */
+  explicit thread_pool(std::size_t workers) : queues_(std::max<std::size_t>(workers, 1)) {
+    for (auto& queue : queues_) queue = std::make_unique<task_queue>();
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back([this, i](std::stop_token const& stop) { work(stop, i); });
+    }
+  }
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool(thread_pool&&) = delete;
+  auto operator=(thread_pool const&) -> thread_pool& = delete;
+  auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+  ~thread_pool() {
+    for (auto& thread : threads_) thread.request_stop();
+    {
+      std::scoped_lock const lock(wake_mutex_);
+      wake_.notify_all();
+    }
+    threads_.clear();
+  }
+
+  /**
+   * @brief Shared pool with a worker for every hardware thread except the calling one
+   */
+  [[nodiscard]] static auto default_pool() -> thread_pool& {
+    static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1U) - 1);
+    return pool;
+  }
+
+  /**
+   * @brief Number of threads running tasks, including the calling thread
+   */
+  [[nodiscard]] auto concurrency() const noexcept -> std::size_t { return threads_.size() + 1; }
+
+  /**
+   * @brief Call <code>fn(i)</code> for every i in [0, count) concurrently and wait for all calls to finish
+   *
+   * @throws the first exception thrown by <code>fn</code> after all calls have finished
+   */
+  template <class Fn>
+  void run(std::size_t count, Fn&& fn) {
+    if (count == 0) return;
+    batch work{.fn = std::addressof(fn),
+               .call = [](void* f, std::size_t i) { std::invoke(*static_cast<std::remove_reference_t<Fn>*>(f), i); },
+               .remaining = count};
+
+    // counted before pushing so that workers never decrement below zero
+    pending_.fetch_add(count, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+      auto& queue = *queues_[i % queues_.size()];
+      std::scoped_lock const lock(queue.mutex);
+      queue.tasks.push_back({&work, i});
+    }
+    {
+      std::scoped_lock const lock(wake_mutex_);
+      wake_.notify_all();
+    }
+
+    // help until every task of this batch has been taken, then wait for the ones still running
+    while (try_run_one(0)) {
+    }
+    std::unique_lock lock(work.mutex);
+    work.done.wait(lock, [&work] { return work.remaining == 0; });
+    if (work.error) std::rethrow_exception(work.error);
+  }
+
+ private:
+  struct batch {
+    void* fn;
+    void (*call)(void*, std::size_t);
+    std::size_t remaining;
+    std::exception_ptr error{};
+    std::mutex mutex{};
+    std::condition_variable done{};
+  };
+
+  struct task {
+    batch* work;
+    std::size_t index;
+  };
+
+  struct task_queue {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  std::vector<std::unique_ptr<task_queue>> queues_;
+  std::atomic<std::size_t> pending_{0};
+  std::mutex wake_mutex_;
+  std::condition_variable_any wake_;
+  // declared last so that workers are joined before anything they use is destroyed
+  std::vector<std::jthread> threads_;
+
+  auto pop(std::size_t self, task& out) -> bool {
+    for (std::size_t offset = 0; offset < queues_.size(); ++offset) {
+      auto& queue = *queues_[(self + offset) % queues_.size()];
+      std::scoped_lock const lock(queue.mutex);
+      if (queue.tasks.empty()) continue;
+      if (offset == 0) {
+        out = queue.tasks.front();
+        queue.tasks.pop_front();
+      } else {
+        out = queue.tasks.back();
+        queue.tasks.pop_back();
+      }
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  auto try_run_one(std::size_t self) -> bool {
+    task next{};
+    if (!pop(self, next)) return false;
+    execute(next);
+    return true;
+  }
+
+  static void execute(task const& next) {
+    auto& work = *next.work;
+    std::exception_ptr error;
+    try {
+      work.call(work.fn, next.index);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    // notify while holding the lock, the batch may be destroyed as soon as it is released
+    std::scoped_lock const lock(work.mutex);
+    if (error && !work.error) work.error = std::move(error);
+    if (--work.remaining == 0) work.done.notify_all();
+  }
+
+  void work(std::stop_token const& stop, std::size_t self) {
+    while (!stop.stop_requested()) {
+      if (try_run_one(self)) continue;
+      std::unique_lock lock(wake_mutex_);
+      wake_.wait(lock, stop, [this] { return pending_.load(std::memory_order_relaxed) > 0; });
+    }
+  }
+};
+
+namespace _ifacade_detail {
+
+/// \brief Call `fn(chunk_first, chunk_last, chunk_index)` on the pool for balanced chunks of [first, first + size)
+template <class I, class Fn>
+void for_each_chunk(thread_pool& pool, I const& first, std::iter_difference_t<I> size, Fn fn) {
+  auto const chunks = ::ITERATOR_FACADE_NS::split(first, first + size, pool.concurrency() * ITERF_PARALLEL_TASKS_PER_THREAD);
+  pool.run(chunks.size(), [&](std::size_t chunk) { fn(chunks[chunk].begin(), chunks[chunk].end(), chunk); });
+}
+
+}  // namespace _ifacade_detail
+
+/**
+ * @brief Apply `f` to every element in [first, last) concurrently, `f` must be safe to call from several threads
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class F>
+  requires std::indirectly_unary_invocable<F const&, I>
+void parallel_for_each(thread_pool& pool, I first, S last, F const& f) {
+  _ifacade_detail::for_each_chunk(pool, first, last - first, [&f](I chunk_first, I chunk_last, std::size_t) {
+    ::ITERATOR_FACADE_NS::for_each(std::move(chunk_first), std::move(chunk_last), std::cref(f));
+  });
+}
+
+/**
+ * @brief \ref parallel_for_each on \ref thread_pool::default_pool
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class F>
+  requires std::indirectly_unary_invocable<F const&, I>
+void parallel_for_each(I first, S last, F const& f) {
+  parallel_for_each(thread_pool::default_pool(), std::move(first), std::move(last), f);
+}
+
+/**
+ * @brief Reduce the transformed elements in [first, last) with `reduce`, starting from `init`
+ *
+ * Every chunk is reduced concurrently and the partial results are then reduced in order, so `reduce` has to be
+ * associative but need not be commutative.
+ *
+ * @return the reduced value
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class T, class Reduce, class Transform>
+auto parallel_transform_reduce(thread_pool& pool, I first, S last, T init, Reduce reduce, Transform transform) -> T {
+  auto const size = last - first;
+  if (size <= 0) return init;
+
+  std::vector<std::optional<T>> partials(pool.concurrency() * ITERF_PARALLEL_TASKS_PER_THREAD);
+  _ifacade_detail::for_each_chunk(pool, first, size, [&](I it, I chunk_last, std::size_t chunk) {
+    T partial = std::invoke(transform, *it);
+    for (++it; it != chunk_last; ++it) partial = std::invoke(reduce, std::move(partial), std::invoke(transform, *it));
+    partials[chunk].emplace(std::move(partial));
+  });
+
+  for (auto& partial : partials) {
+    if (partial) init = std::invoke(reduce, std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+/**
+ * @brief \ref parallel_transform_reduce on \ref thread_pool::default_pool
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, class T, class Reduce = std::plus<>,
+          class Transform = std::identity>
+auto parallel_transform_reduce(I first, S last, T init, Reduce reduce = {}, Transform transform = {}) -> T {
+  return parallel_transform_reduce(thread_pool::default_pool(), std::move(first), std::move(last), std::move(init),
+                                   std::move(reduce), std::move(transform));
+}
+
+/**
+ * @brief Copy [first, last) to [out, out + (last - first)) concurrently
+ *
+ * @return output iterator past the last copied element
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O>
+  requires std::indirectly_copyable<I, O>
+auto parallel_copy(thread_pool& pool, I first, S last, O out) -> O {
+  auto const size = last - first;
+  if (size <= 0) return out;
+  _ifacade_detail::for_each_chunk(pool, first, size, [&first, &out](I chunk_first, I chunk_last, std::size_t) {
+    ::ITERATOR_FACADE_NS::copy(chunk_first, chunk_last, out + static_cast<std::iter_difference_t<O>>(chunk_first - first));
+  });
+  return out + static_cast<std::iter_difference_t<O>>(size);
+}
+
+/**
+ * @brief \ref parallel_copy on \ref thread_pool::default_pool
+ */
+template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O>
+  requires std::indirectly_copyable<I, O>
+auto parallel_copy(I first, S last, O out) -> O {
+  return parallel_copy(thread_pool::default_pool(), std::move(first), std::move(last), std::move(out));
+}
+
+/** @} */  // end of parallel
+
+}  // namespace ITERATOR_FACADE_NS
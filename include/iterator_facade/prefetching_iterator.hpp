@@ -0,0 +1,151 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+#ifndef ITERF_PREFETCH
+#  if defined(__GNUC__) || defined(__clang__)
+/// Hint that the cache line at <code>address</code> will be read soon, never faults
+#    define ITERF_PREFETCH(address) __builtin_prefetch(address)
+#  else
+#    define ITERF_PREFETCH(address) static_cast<void>(address)
+#  endif
+#endif
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+// random access iterators compute the prefetched position, they do not need a lookahead copy
+struct no_lookahead {};
+
+}  // namespace _ifacade_detail
+
+/** @defgroup prefetching Prefetching iterator
+ *  @{
+ */
+
+/**
+ * @brief Iterator adaptor which prefetches the element <code>Distance</code> steps ahead on every increment
+ *
+ * Memory latency bound traversals, e.g. of a permutation (<code>base[index[i]]</code>) or of linked nodes, overlap
+ * the cache misses of the next <code>Distance</code> elements with the work on the current one. The prefetched
+ * address is the address of the element the underlying iterator dereferences to, so indirect iterators prefetch the
+ * indirectly accessed element while reading their indices sequentially.
+ *
+ * Random access iterators prefetch <code>base[Distance]</code> while it is before the end. Forward iterators keep a
+ * copy <code>Distance</code> steps ahead (bounded by the end) which is incremented along, so pointer chasing
+ * iterators follow the links twice but the second walk hits the cache. Prefetching never dereferences past the end.
+ *
+ * @tparam Iter underlying forward iterator dereferencing to an lvalue, the category is random access if Iter is and
+ * forward otherwise
+ * @tparam Distance number of elements to prefetch ahead, tuned to the memory latency divided by the work per element
+ */
+template <std::forward_iterator Iter, std::ptrdiff_t Distance = 16>
+  requires(std::is_lvalue_reference_v<std::iter_reference_t<Iter>> && Distance > 0)
+class prefetching_iterator : public iterator_facade<prefetching_iterator<Iter, Distance>> {
+ public:
+  using value_type = std::iter_value_t<Iter>;
+  using reference = std::iter_reference_t<Iter>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  constexpr static bool random_access = std::random_access_iterator<Iter>;
+  constexpr static difference_type distance = Distance;
+
+  constexpr prefetching_iterator() = default;
+
+  /**
+   * @brief Iterator at <code>base</code> in a sequence ending at <code>last</code>
+   */
+  constexpr prefetching_iterator(Iter base, Iter last) noexcept(std::is_nothrow_copy_constructible_v<Iter>&&
+                                                                    nothrow_increment<Iter>)
+      : base_(std::move(base)), last_(std::move(last)) {
+    if constexpr (!random_access) {
+      ahead_ = base_;
+      for (difference_type i = 0; i < Distance && ahead_ != last_; ++i) ++ahead_;
+    }
+  }
+
+  [[nodiscard]] constexpr auto base() const noexcept -> Iter const& { return base_; }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept(nothrow_dereference<Iter>)
+      -> reference {
+    return *base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() noexcept(nothrow_increment<Iter>&& nothrow_dereference<Iter>) {
+    ++base_;
+    if constexpr (random_access) {
+      if (last_ - base_ > Distance) prefetch(base_[Distance]);
+    } else if (ahead_ != last_) {
+      ++ahead_;
+      if (ahead_ != last_) prefetch(*ahead_);
+    }
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(prefetching_iterator const& other) const
+      noexcept(noexcept(base_ == other.base_)) -> bool {
+    return base_ == other.base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement() noexcept(nothrow_decrement<Iter>)
+    requires(random_access)
+  {
+    --base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept(nothrow_advance<Iter>)
+    requires(random_access)
+  {
+    base_ += n;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(prefetching_iterator const& other) const
+      noexcept(noexcept(other.base_ - base_)) -> difference_type
+    requires(random_access)
+  {
+    return other.base_ - base_;
+  }
+
+ private:
+  Iter base_{};
+  Iter last_{};
+  [[no_unique_address]] std::conditional_t<random_access, _ifacade_detail::no_lookahead, Iter> ahead_{};
+
+  ITERF_ALWAYS_INLINE constexpr static void prefetch(reference element) noexcept {
+    if (!std::is_constant_evaluated()) ITERF_PREFETCH(std::addressof(element));
+  }
+};
+
+/**
+ * @brief Range over <code>range</code> which prefetches <code>Distance</code> elements ahead
+ *
+ * @return std::ranges::subrange<prefetching_iterator<std::ranges::iterator_t<R>, Distance>>
+ */
+template <std::ptrdiff_t Distance = 16, std::ranges::forward_range R>
+  requires(std::ranges::common_range<R> && std::ranges::borrowed_range<R>)
+[[nodiscard]] constexpr auto prefetched(R&& range)
+    -> std::ranges::subrange<prefetching_iterator<std::ranges::iterator_t<R>, Distance>> {
+  using iterator = prefetching_iterator<std::ranges::iterator_t<R>, Distance>;
+  auto last = std::ranges::end(range);
+  return {iterator(std::ranges::begin(range), last), iterator(last, last)};
+}
+
+/** @} */  // end of prefetching
+
+}  // namespace ITERATOR_FACADE_NS
@@ -0,0 +1,145 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+/** @defgroup reverse Reverse iterator
+ *  @{
+ */
+
+/**
+ * @brief Reverse iterator which decrements the underlying iterator once per element
+ *
+ * <code>std::reverse_iterator</code> copies and decrements its base on every dereference and decrements it again on
+ * increment, which doubles the cost of reverse traversal for iterators with an expensive <code>decrement()</code>
+ * (variable length encodings, segmented storage). <code>reverse_facade</code> keeps the decremented position computed by
+ * the first dereference and moves it into the base on increment, so every element is only decremented once.
+ *
+ * The cached position is computed lazily, so the end iterator never decrements past the beginning of the sequence.
+ * Dereferencing writes the cache of a <code>const</code> iterator, so an iterator must not be dereferenced by several
+ * threads at once. Like <code>std::reverse_iterator</code> it must not be used with iterators that return references to
+ * values they own.
+ *
+ * @tparam Iter underlying bidirectional iterator, the category of the reversed iterator is the same
+ */
+template <std::bidirectional_iterator Iter>
+class reverse_facade : public iterator_facade<reverse_facade<Iter>> {
+ public:
+  using value_type = std::iter_value_t<Iter>;
+  using reference = std::iter_reference_t<Iter>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  constexpr reverse_facade() = default;
+
+  /**
+   * @brief Iterator to the element before <code>base</code>, like <code>std::reverse_iterator(base)</code>
+   */
+  constexpr explicit reverse_facade(Iter base) noexcept(std::is_nothrow_move_constructible_v<Iter>)
+      : base_(std::move(base)) {}
+
+  /**
+   * @brief Iterator one past the referenced element in the underlying sequence
+   */
+  [[nodiscard]] constexpr auto base() const noexcept -> Iter const& { return base_; }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const
+      noexcept(nothrow_dereference<Iter>&& nothrow_decrement<Iter>&& std::is_nothrow_copy_constructible_v<Iter>)
+          -> reference {
+    return *position();
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() noexcept(
+      nothrow_decrement<Iter>&& std::is_nothrow_move_assignable_v<Iter>) {
+    if (previous_) {
+      base_ = std::move(*previous_);
+      previous_.reset();
+    } else {
+      --base_;
+    }
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement() noexcept(
+      nothrow_increment<Iter>&& std::is_nothrow_copy_constructible_v<Iter>) {
+    // the current base is the decremented position of the next one
+    previous_.emplace(base_);
+    ++base_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept(nothrow_advance<Iter>)
+    requires(std::random_access_iterator<Iter>)
+  {
+    base_ -= n;
+    previous_.reset();
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(reverse_facade const& other) const
+      noexcept(noexcept(base_ == other.base_)) -> bool {
+    return base_ == other.base_;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(reverse_facade const& other) const
+      noexcept(noexcept(base_ - other.base_)) -> difference_type
+    requires(std::sized_sentinel_for<Iter, Iter>)
+  {
+    return base_ - other.base_;
+  }
+
+  [[nodiscard]] constexpr auto iter_move() const
+      noexcept(noexcept(std::ranges::iter_move(std::declval<Iter const&>())) && nothrow_decrement<Iter> &&
+               std::is_nothrow_copy_constructible_v<Iter>) -> std::iter_rvalue_reference_t<Iter> {
+    return std::ranges::iter_move(position());
+  }
+
+  template <std::indirectly_swappable<Iter> Other>
+  constexpr void iter_swap(reverse_facade<Other> const& other) const
+      noexcept(noexcept(std::ranges::iter_swap(std::declval<Iter const&>(), std::declval<Other const&>())) &&
+               nothrow_decrement<Iter> && std::is_nothrow_copy_constructible_v<Iter> && nothrow_decrement<Other> &&
+               std::is_nothrow_copy_constructible_v<Other>) {
+    std::ranges::iter_swap(position(), other.position());
+  }
+
+ private:
+  template <std::bidirectional_iterator>
+  friend class reverse_facade;
+
+  Iter base_{};
+  mutable std::optional<Iter> previous_{};
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto position() const
+      noexcept(nothrow_decrement<Iter>&& std::is_nothrow_copy_constructible_v<Iter>) -> Iter const& {
+    if (!previous_) --previous_.emplace(base_);
+    return *previous_;
+  }
+};
+
+/**
+ * @brief Reverse a common bidirectional range with \ref reverse_facade
+ *
+ * @return std::ranges::subrange<reverse_facade<std::ranges::iterator_t<R>>>
+ */
+template <std::ranges::bidirectional_range R>
+  requires(std::ranges::common_range<R> && std::ranges::borrowed_range<R>)
+[[nodiscard]] constexpr auto reversed(R&& range) -> std::ranges::subrange<reverse_facade<std::ranges::iterator_t<R>>> {
+  using iterator = reverse_facade<std::ranges::iterator_t<R>>;
+  return {iterator(std::ranges::end(range)), iterator(std::ranges::begin(range))};
+}
+
+/** @} */  // end of reverse
+
+}  // namespace ITERATOR_FACADE_NS
@@ -0,0 +1,168 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+/// Stride value of \ref strided_iterator which is only known at runtime
+inline constexpr std::ptrdiff_t dynamic_stride = std::numeric_limits<std::ptrdiff_t>::min();
+
+namespace _ifacade_detail {
+
+template <class D, std::ptrdiff_t Stride>
+struct stride_storage {
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr static auto value() noexcept -> D { return static_cast<D>(Stride); }
+};
+
+template <class D>
+struct stride_storage<D, dynamic_stride> {
+  D stride = 1;
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto value() const noexcept -> D { return stride; }
+};
+
+}  // namespace _ifacade_detail
+
+/** @defgroup strided Strided iterator
+ *  @{
+ */
+
+/**
+ * @brief Random access iterator over every <code>Stride</code>-th element of <code>Iter</code>, e.g. a column of a
+ * row-major matrix or one channel of interleaved audio
+ *
+ * The position is stored as the base iterator and an element index which is scaled by the stride only when
+ * dereferencing, so the end iterator never has to point past the underlying sequence. With a compile time stride the
+ * scaling folds into the addressing of the dereference and loops over the iterator vectorize like loops over
+ * <code>base[i * Stride]</code>.
+ *
+ * @tparam Iter underlying random access iterator
+ * @tparam Stride distance between consecutive elements in <code>Iter</code> or \ref dynamic_stride for a runtime
+ * stride
+ */
+template <std::random_access_iterator Iter, std::ptrdiff_t Stride = dynamic_stride>
+class strided_iterator : public iterator_facade<strided_iterator<Iter, Stride>> {
+ public:
+  using value_type = std::iter_value_t<Iter>;
+  using reference = std::iter_reference_t<Iter>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  constexpr static bool static_stride = Stride != dynamic_stride;
+
+  static_assert(Stride != 0, "stride must not be 0");
+
+  constexpr strided_iterator() noexcept(std::is_nothrow_default_constructible_v<Iter>) = default;
+
+  /**
+   * @brief Iterator to the element at <code>base[index * Stride]</code>
+   */
+  constexpr explicit strided_iterator(Iter base, difference_type index = 0) noexcept(
+      std::is_nothrow_move_constructible_v<Iter>)
+    requires(static_stride)
+      : base_(std::move(base)), index_(index) {}
+
+  /**
+   * @brief Iterator to the element at <code>base[index * stride]</code>
+   */
+  constexpr strided_iterator(Iter base, difference_type index, difference_type stride) noexcept(
+      std::is_nothrow_move_constructible_v<Iter>)
+    requires(!static_stride)
+      : base_(std::move(base)), index_(index), stride_{stride} {}
+
+  [[nodiscard]] constexpr auto base() const noexcept -> Iter const& { return base_; }
+  [[nodiscard]] constexpr auto index() const noexcept -> difference_type { return index_; }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto stride() const noexcept -> difference_type { return stride_.value(); }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept(nothrow_dereference<Iter>)
+      -> reference {
+    return base_[index_ * stride()];
+  }
+  ITERF_ALWAYS_INLINE constexpr void advance(difference_type n) noexcept { index_ += n; }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto distance_to(strided_iterator const& other) const noexcept
+      -> difference_type {
+    return other.index_ - index_;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto iter_move() const
+      noexcept(noexcept(std::ranges::iter_move(std::declval<Iter const&>())) && nothrow_advance<Iter>)
+          -> std::iter_rvalue_reference_t<Iter> {
+    return std::ranges::iter_move(position());
+  }
+  ITERF_ALWAYS_INLINE constexpr void iter_swap(strided_iterator const& other) const
+      noexcept(noexcept(std::ranges::iter_swap(std::declval<Iter const&>(), std::declval<Iter const&>())) &&
+               nothrow_advance<Iter>) {
+    std::ranges::iter_swap(position(), other.position());
+  }
+
+  /**
+   * @brief Load <code>N</code> consecutive strided elements starting at this position in one batch
+   *
+   * The loads are independent of each other, so for a contiguous <code>Iter</code> the compiler can emit them as a
+   * SIMD gather when the target supports it (e.g. <code>vpgatherdd</code> with AVX2).
+   *
+   * @tparam N number of elements, <code>*this + (N - 1)</code> must be dereferenceable
+   * @return std::array<value_type, N>
+   */
+  template <std::size_t N>
+  [[nodiscard]] constexpr auto gather() const noexcept(nothrow_dereference<Iter>&&
+                                                           std::is_nothrow_copy_constructible_v<value_type>)
+      -> std::array<value_type, N> {
+    return gather_impl(std::make_index_sequence<N>{});
+  }
+
+ private:
+  Iter base_{};
+  difference_type index_ = 0;
+  [[no_unique_address]] _ifacade_detail::stride_storage<difference_type, Stride> stride_;
+
+  [[nodiscard]] constexpr auto position() const noexcept(nothrow_advance<Iter>) -> Iter {
+    return base_ + index_ * stride();
+  }
+
+  template <std::size_t... I>
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto gather_impl(std::index_sequence<I...> /*unused*/) const
+      -> std::array<value_type, sizeof...(I)> {
+    auto const first = index_ * stride();
+    return {static_cast<value_type>(base_[first + static_cast<difference_type>(I) * stride()])...};
+  }
+};
+
+/**
+ * @brief Range of <code>count</code> elements of <code>base</code> with a compile time stride
+ */
+template <std::ptrdiff_t Stride, std::random_access_iterator Iter>
+  requires(Stride != dynamic_stride)
+[[nodiscard]] constexpr auto strided(Iter base, std::iter_difference_t<Iter> count)
+    -> std::ranges::subrange<strided_iterator<Iter, Stride>> {
+  return {strided_iterator<Iter, Stride>(base, 0), strided_iterator<Iter, Stride>(base, count)};
+}
+
+/**
+ * @brief Range of <code>count</code> elements of <code>base</code> with a runtime stride
+ */
+template <std::random_access_iterator Iter>
+[[nodiscard]] constexpr auto strided(Iter base, std::iter_difference_t<Iter> count,
+                                     std::iter_difference_t<Iter> stride)
+    -> std::ranges::subrange<strided_iterator<Iter>> {
+  return {strided_iterator<Iter>(base, 0, stride), strided_iterator<Iter>(base, count, stride)};
+}
+
+/** @} */  // end of strided
+
+}  // namespace ITERATOR_FACADE_NS
@@ -0,0 +1,290 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#endif
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+// clang-format off
+template <class C>
+concept utf8_char = std::same_as<C, char> || std::same_as<C, char8_t> || std::same_as<C, unsigned char>;
+// clang-format on
+
+template <class Char>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto utf8_byte(Char c) noexcept -> std::uint32_t {
+  return static_cast<std::uint32_t>(c) & 0xFFU;
+}
+
+/// \brief Continuation bytes are 0b10xxxxxx, every other byte starts a code point
+template <class Char>
+[[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto is_continuation(Char c) noexcept -> bool {
+  return (utf8_byte(c) & 0xC0U) == 0x80U;
+}
+
+/// \brief Counts the bytes which start a code point in the 8 bytes at `bytes` within a 64 bit word (SWAR), the
+/// fallback without vector instructions
+template <class Char>
+[[nodiscard]] ITERF_ALWAYS_INLINE auto swar_utf8_leads(Char const* bytes) noexcept -> std::ptrdiff_t {
+  std::uint64_t word = 0;
+  std::memcpy(&word, bytes, sizeof(word));
+  // the high bit of a byte is set if it is 0b10xxxxxx, bits shifted over byte boundaries are masked out
+  auto const continuations = word & ~(word << 1U) & 0x8080808080808080ULL;
+  return static_cast<std::ptrdiff_t>(sizeof(word)) - std::popcount(continuations);
+}
+
+/// \brief Counts the bytes which start a code point in a chunk of `size` bytes
+struct utf8_chunk {
+#if defined(__AVX2__)
+  constexpr static std::ptrdiff_t size = 32;
+
+  template <class Char>
+  [[nodiscard]] ITERF_ALWAYS_INLINE static auto leads(Char const* bytes) noexcept -> std::ptrdiff_t {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes));
+    // as signed bytes continuation bytes are [-128, -65]
+    auto const mask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(static_cast<char>(-65))));
+    return std::popcount(static_cast<std::uint32_t>(mask));
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  constexpr static std::ptrdiff_t size = 16;
+
+  template <class Char>
+  [[nodiscard]] ITERF_ALWAYS_INLINE static auto leads(Char const* bytes) noexcept -> std::ptrdiff_t {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes));
+    // as signed bytes continuation bytes are [-128, -65]
+    auto const mask = _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(static_cast<char>(-65))));
+    return std::popcount(static_cast<std::uint32_t>(mask));
+  }
+#else
+  constexpr static std::ptrdiff_t size = 8;
+
+  template <class Char>
+  [[nodiscard]] ITERF_ALWAYS_INLINE static auto leads(Char const* bytes) noexcept -> std::ptrdiff_t {
+    return swar_utf8_leads(bytes);
+  }
+#endif
+};
+
+/// \brief Number of bytes in [first, last) which start a code point
+template <class Char>
+[[nodiscard]] constexpr auto count_utf8_leads(Char const* first, Char const* last) noexcept -> std::ptrdiff_t {
+  std::ptrdiff_t count = 0;
+  if (!std::is_constant_evaluated()) {
+    for (; last - first >= utf8_chunk::size; first += utf8_chunk::size) count += utf8_chunk::leads(first);
+  }
+  for (; first != last; ++first) count += is_continuation(*first) ? 0 : 1;
+  return count;
+}
+
+/// \brief Position of the byte in [first, last) which starts the code point after the next `n` ones, or `last`
+template <class Char>
+[[nodiscard]] constexpr auto skip_utf8_leads(Char const* first, Char const* last, std::ptrdiff_t n) noexcept
+    -> Char const* {
+  if (!std::is_constant_evaluated()) {
+    while (last - first >= utf8_chunk::size) {
+      auto const leads = utf8_chunk::leads(first);
+      if (leads > n) break;
+      n -= leads;
+      first += utf8_chunk::size;
+    }
+  }
+  for (; first != last; ++first) {
+    if (!is_continuation(*first) && n-- == 0) return first;
+  }
+  return last;
+}
+
+/// \brief Position of the byte in [first, last) which starts the code point before the previous `n` ones, or `first`
+template <class Char>
+[[nodiscard]] constexpr auto skip_utf8_leads_backward(Char const* first, Char const* last, std::ptrdiff_t n) noexcept
+    -> Char const* {
+  if (!std::is_constant_evaluated()) {
+    while (last - first >= utf8_chunk::size) {
+      auto const leads = utf8_chunk::leads(last - utf8_chunk::size);
+      if (leads > n) break;
+      n -= leads;
+      last -= utf8_chunk::size;
+    }
+  }
+  while (last != first) {
+    --last;
+    if (!is_continuation(*last) && n-- == 0) return last;
+  }
+  return first;
+}
+
+/// \brief Decode the code point at `first`, which spans all continuation bytes after it before `last`
+template <class Char>
+[[nodiscard]] constexpr auto decode_utf8(Char const* first, Char const* last) noexcept -> char32_t {
+  constexpr char32_t replacement = U'\uFFFD';
+
+  auto const lead = utf8_byte(*first);
+  std::ptrdiff_t length = 0;
+  std::uint32_t code_point = 0;
+  std::uint32_t min = 0;
+  if (lead < 0x80U) {
+    length = 1;
+    code_point = lead;
+  } else if (lead < 0xC0U) {
+    return replacement;
+  } else if (lead < 0xE0U) {
+    length = 2;
+    code_point = lead & 0x1FU;
+    min = 0x80U;
+  } else if (lead < 0xF0U) {
+    length = 3;
+    code_point = lead & 0x0FU;
+    min = 0x800U;
+  } else if (lead < 0xF8U) {
+    length = 4;
+    code_point = lead & 0x07U;
+    min = 0x10000U;
+  } else {
+    return replacement;
+  }
+
+  if (last - first < length) return replacement;
+  for (std::ptrdiff_t i = 1; i < length; ++i) {
+    if (!is_continuation(first[i])) return replacement;
+    code_point = (code_point << 6U) | (utf8_byte(first[i]) & 0x3FU);
+  }
+  // the code point also spans stray continuation bytes after a complete sequence
+  if (last - first > length && is_continuation(first[length])) return replacement;
+  // overlong encodings, surrogates and values beyond the Unicode range
+  if (code_point < min || code_point > 0x10FFFFU || (code_point >= 0xD800U && code_point <= 0xDFFFU)) {
+    return replacement;
+  }
+  return static_cast<char32_t>(code_point);
+}
+
+}  // namespace _ifacade_detail
+
+/** @defgroup utf8 UTF-8 iterator
+ *  @{
+ */
+
+/**
+ * @brief Bidirectional iterator decoding the code points of UTF-8 text
+ *
+ * A code point starts at every byte which is not a continuation byte (<code>0b10xxxxxx</code>) and spans the
+ * continuation bytes after it, so the number of code points between two iterators is the number of such bytes.
+ * <code>distance_to</code> counts them and the hidden friend <code>advance(it, n)</code> skips them 32 (AVX2),
+ * 16 (SSE2) or 8 bytes at a time instead of decoding every code point, <code>last - first</code> and
+ * <code>std::ranges::distance</code> use the former. <code>std::ranges::advance</code> still increments one code point
+ * at a time, as the iterator is not random access. <code>std::distance</code> gets no speedup either: it only sees the
+ * bidirectional iterator category and loops over <code>++it</code>, use <code>last - first</code> instead.
+ *
+ * Malformed code points, i.e. truncated or overlong sequences, sequences with stray continuation bytes, surrogates and
+ * values above U+10FFFF, decode to one U+FFFD replacement character each. The iterator keeps the bounds of the text so
+ * that malformed text is never read out of bounds.
+ *
+ * @tparam Char <code>char</code>, <code>char8_t</code> or <code>unsigned char</code>
+ */
+template <_ifacade_detail::utf8_char Char = char>
+class utf8_iterator : public iterator_facade<utf8_iterator<Char>> {
+ public:
+  using value_type = char32_t;
+  using reference = char32_t;
+  using difference_type = std::ptrdiff_t;
+
+  constexpr utf8_iterator() noexcept = default;
+
+  /**
+   * @brief Iterator to the code point starting at <code>position</code> in the text [first, last)
+   */
+  constexpr utf8_iterator(Char const* first, Char const* position, Char const* last) noexcept
+      : first_(first), position_(position), last_(last) {}
+
+  /**
+   * @brief First byte of the current code point
+   */
+  [[nodiscard]] constexpr auto base() const noexcept -> Char const* { return position_; }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto dereference() const noexcept -> char32_t {
+    return _ifacade_detail::decode_utf8(position_, last_);
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void increment() noexcept {
+    ++position_;
+    while (position_ != last_ && _ifacade_detail::is_continuation(*position_)) ++position_;
+  }
+
+  ITERF_ALWAYS_INLINE constexpr void decrement() noexcept {
+    --position_;
+    while (position_ != first_ && _ifacade_detail::is_continuation(*position_)) --position_;
+  }
+
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto equals(utf8_iterator const& other) const noexcept -> bool {
+    return position_ == other.position_;
+  }
+
+  [[nodiscard]] constexpr auto distance_to(utf8_iterator const& other) const noexcept -> difference_type {
+    // the code point at the earlier position counts even if the text starts with continuation bytes
+    if (position_ < other.position_) return 1 + _ifacade_detail::count_utf8_leads(position_ + 1, other.position_);
+    if (other.position_ < position_) return -1 - _ifacade_detail::count_utf8_leads(other.position_ + 1, position_);
+    return 0;
+  }
+
+  /**
+   * @brief Move <code>it</code> by <code>n</code> code points, skipping whole chunks of bytes
+   */
+  friend constexpr void advance(utf8_iterator& it, difference_type n) noexcept {
+    if (n > 0) {
+      it.position_ = _ifacade_detail::skip_utf8_leads(it.position_ + 1, it.last_, n - 1);
+    } else if (n < 0) {
+      it.position_ = _ifacade_detail::skip_utf8_leads_backward(it.first_, it.position_, -n - 1);
+    }
+  }
+
+ private:
+  Char const* first_ = nullptr;
+  Char const* position_ = nullptr;
+  Char const* last_ = nullptr;
+};
+
+/**
+ * @brief Range of the code points of the UTF-8 text <code>text</code>
+ *
+ * String literals include their terminating null character, pass a <code>std::string_view</code> instead.
+ *
+ * @return std::ranges::subrange<utf8_iterator<Char>>, sized in O(n / chunk size)
+ */
+template <std::ranges::contiguous_range R>
+  requires(std::ranges::sized_range<R> && std::ranges::borrowed_range<R> &&
+           _ifacade_detail::utf8_char<std::ranges::range_value_t<R>>)
+[[nodiscard]] constexpr auto utf8(R&& text) -> std::ranges::subrange<utf8_iterator<std::ranges::range_value_t<R>>> {
+  using iterator = utf8_iterator<std::ranges::range_value_t<R>>;
+  auto const* first = std::ranges::data(text);
+  auto const* last = first + std::ranges::size(text);
+  return {iterator(first, first, last), iterator(first, last, last)};
+}
+
+/** @} */  // end of utf8
+
+}  // namespace ITERATOR_FACADE_NS
@@ -0,0 +1,169 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+// clang-format off
+template <class T>
+concept has_make_begin = requires(T& view) {
+  { view.make_begin() } -> std::input_or_output_iterator;
+};
+template <class T>
+concept has_nothrow_make_begin = requires(T& view) {
+  { view.make_begin() } noexcept;
+};
+
+template <class T>
+concept has_make_end = requires(T& view) {
+  view.make_end();
+};
+template <class T>
+concept has_nothrow_make_end = requires(T& view) {
+  { view.make_end() } noexcept;
+};
+// clang-format on
+
+/// \brief Optional value which is reset instead of copied so that cached iterators never refer to another view
+template <class T>
+class non_propagating_cache {
+ public:
+  constexpr non_propagating_cache() noexcept = default;
+  constexpr non_propagating_cache(non_propagating_cache const& /*unused*/) noexcept {}
+  constexpr non_propagating_cache(non_propagating_cache&& other) noexcept { other.value_.reset(); }
+  constexpr ~non_propagating_cache() noexcept = default;
+
+  constexpr auto operator=(non_propagating_cache const& other) noexcept -> non_propagating_cache& {
+    if (this != &other) value_.reset();
+    return *this;
+  }
+  constexpr auto operator=(non_propagating_cache&& other) noexcept -> non_propagating_cache& {
+    value_.reset();
+    other.value_.reset();
+    return *this;
+  }
+
+  template <class F>
+  [[nodiscard]] constexpr auto get_or_emplace(F&& factory) noexcept(std::is_nothrow_invocable_v<F>) -> T& {
+    if (!value_) value_.emplace(std::invoke(std::forward<F>(factory)));
+    return *value_;
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+template <>
+class non_propagating_cache<void> {};
+
+}  // namespace _ifacade_detail
+
+/** @defgroup view View facade
+ *  @{
+ */
+
+/**
+ * @brief View facade which provides <code>begin()</code> and <code>end()</code> from the derived class hooks, everything
+ * else (<code>size()</code>, <code>data()</code>, <code>empty()</code>, <code>front()</code>, ...) is inferred by
+ * <code>std::ranges::view_interface</code> from the iterator and sentinel types
+ *
+ * @tparam Derived view subclass type which implements: <br>
+ *    *   <code>auto make_begin() [const] -> iterator </code> <br>
+ *    *   <code>auto make_end() [const] -> sentinel </code> <br>
+ *
+ *    The view is sized if <code>sentinel - iterator</code> is valid, e.g. an \ref iterator_facade iterator with
+ *    <code>distance_to(sentinel)</code>, and <code>data()</code> is available if the iterator is contiguous.
+ *
+ * @tparam CachedBegin iterator type returned by <code>make_begin()</code> if it should be computed only once (when it is
+ * not O(1)), otherwise void. A cached view has no <code>const</code> <code>begin()</code> and copies of the view do not
+ * share the cached iterator.
+ */
+template <class Derived, class CachedBegin = void>
+class view_facade : public std::ranges::view_interface<Derived> {
+ public:
+  using self_type = Derived;
+
+  constexpr static bool caches_begin = !std::is_void_v<CachedBegin>;
+
+ private:
+  friend Derived;
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto self() noexcept -> self_type& {
+    return static_cast<self_type&>(*this);
+  }
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto self() const noexcept -> const self_type& {
+    return static_cast<const self_type&>(*this);
+  }
+
+  [[no_unique_address]] _ifacade_detail::non_propagating_cache<CachedBegin> begin_;
+
+ public:
+  /**
+   * @brief Iterator to the first element, requires <code>Derived::make_begin() const</code>
+   */
+  template <class T = self_type>
+    requires(!caches_begin && _ifacade_detail::has_make_begin<T const>)
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto begin() const
+      noexcept(_ifacade_detail::has_nothrow_make_begin<T const>) {
+    return self().make_begin();
+  }
+
+  /**
+   * @brief Iterator to the first element when only <code>Derived::make_begin()</code> is available
+   */
+  template <class T = self_type>
+    requires(!caches_begin && !_ifacade_detail::has_make_begin<T const> && _ifacade_detail::has_make_begin<T>)
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto begin() noexcept(_ifacade_detail::has_nothrow_make_begin<T>) {
+    return self().make_begin();
+  }
+
+  /**
+   * @brief Cached iterator to the first element, <code>Derived::make_begin()</code> is called only on the first call
+   */
+  template <class T = self_type>
+    requires(caches_begin && _ifacade_detail::has_make_begin<T>)
+  [[nodiscard]] constexpr auto begin() noexcept(_ifacade_detail::has_nothrow_make_begin<T> &&
+                                                std::is_nothrow_copy_constructible_v<CachedBegin>) -> CachedBegin {
+    return begin_.get_or_emplace([this]() noexcept(_ifacade_detail::has_nothrow_make_begin<T>) -> CachedBegin {
+      return self().make_begin();
+    });
+  }
+
+  /**
+   * @brief Sentinel, requires <code>Derived::make_end() const</code>
+   */
+  template <class T = self_type>
+    requires(_ifacade_detail::has_make_end<T const>)
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto end() const noexcept(_ifacade_detail::has_nothrow_make_end<T const>) {
+    return self().make_end();
+  }
+
+  /**
+   * @brief Sentinel when only <code>Derived::make_end()</code> is available
+   */
+  template <class T = self_type>
+    requires(!_ifacade_detail::has_make_end<T const> && _ifacade_detail::has_make_end<T>)
+  [[nodiscard]] ITERF_ALWAYS_INLINE constexpr auto end() noexcept(_ifacade_detail::has_nothrow_make_end<T>) {
+    return self().make_end();
+  }
+};
+
+/** @} */  // end of view
+
+}  // namespace ITERATOR_FACADE_NS
@@ -0,0 +1,243 @@
+// iterator_facade by D. Kavolis
+//
+// To the extent possible under law, the person who associated CC0 with
+// iterator_facade has waived all copyright and related or neighboring rights
+// to iterator_facade.
+//
+// You should have received a copy of the CC0 legalcode along with this
+// work.  If not, see <http://creativecommons.org/publicdomain/zero/1.0/>.
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.hpp"
+
+namespace ITERATOR_FACADE_NS {
+
+namespace _ifacade_detail {
+
+template <class Ref>
+struct zipped_value {
+  using type = std::remove_cvref_t<Ref>;
+};
+template <class Ref>
+  requires(proxy_reference<std::remove_cvref_t<Ref>>)
+struct zipped_value<Ref> {
+  using type = typename std::remove_cvref_t<Ref>::proxy_value_type;
+};
+
+}  // namespace _ifacade_detail
+
+/** @defgroup zip Zip iterator
+ *  @{
+ */
+
+/**
+ * @brief Proxy reference to the elements at the same position of several sequences
+ *
+ * Assignments (also to <code>const</code> proxies) write through to the referenced elements, comparisons compare the
+ * referenced elements lexicographically and the proxy converts to a tuple of values. Elements are accessed with
+ * <code>get<I>(reference)</code> or structured bindings.
+ *
+ * @tparam Refs reference types of the zipped iterators
+ */
+template <class... Refs>
+class zip_reference {
+ public:
+  using proxy_value_type = std::tuple<typename _ifacade_detail::zipped_value<Refs>::type...>;
+
+  constexpr explicit zip_reference(Refs... refs) noexcept : refs_(std::forward<Refs>(refs)...) {}
+  constexpr zip_reference(zip_reference const&) noexcept = default;
+  constexpr ~zip_reference() noexcept = default;
+
+  // NOLINTNEXTLINE(cert-oop54-cpp)
+  constexpr auto operator=(zip_reference const& other) const
+      noexcept((std::is_nothrow_assignable_v<Refs, Refs> && ...)) -> zip_reference const& {
+    assign(other.refs_);
+    return *this;
+  }
+  constexpr auto operator=(proxy_value_type const& values) const
+      noexcept((std::is_nothrow_assignable_v<Refs, typename _ifacade_detail::zipped_value<Refs>::type const&> && ...))
+          -> zip_reference const& {
+    assign(values);
+    return *this;
+  }
+  constexpr auto operator=(proxy_value_type&& values) const
+      noexcept((std::is_nothrow_assignable_v<Refs, typename _ifacade_detail::zipped_value<Refs>::type&&> && ...))
+          -> zip_reference const& {
+    assign(std::move(values));
+    return *this;
+  }
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  [[nodiscard]] constexpr operator proxy_value_type() const
+      noexcept((std::is_nothrow_constructible_v<typename _ifacade_detail::zipped_value<Refs>::type, Refs> && ...)) {
+    return std::apply([](auto&&... refs) { return proxy_value_type(refs...); }, refs_);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] friend constexpr auto get(zip_reference const& ref) noexcept
+      -> std::tuple_element_t<I, std::tuple<Refs...>> {
+    return std::get<I>(ref.refs_);
+  }
+
+  friend constexpr void swap(zip_reference const& lhs, zip_reference const& rhs) noexcept(
+      (std::is_nothrow_swappable_with_v<Refs, Refs> && ...)) {
+    [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+      (std::ranges::swap(std::get<I>(lhs.refs_), std::get<I>(rhs.refs_)), ...);
+    }(std::index_sequence_for<Refs...>{});
+  }
+
+  [[nodiscard]] friend constexpr auto operator==(zip_reference const& lhs, zip_reference const& rhs) -> bool {
+    return lhs.refs_ == rhs.refs_;
+  }
+  [[nodiscard]] friend constexpr auto operator==(zip_reference const& lhs, proxy_value_type const& rhs) -> bool {
+    return lhs.refs_ == rhs;
+  }
+  [[nodiscard]] friend constexpr auto operator<=>(zip_reference const& lhs, zip_reference const& rhs) {
+    return lhs.refs_ <=> rhs.refs_;
+  }
+  [[nodiscard]] friend constexpr auto operator<=>(zip_reference const& lhs, proxy_value_type const& rhs) {
+    return lhs.refs_ <=> rhs;
+  }
+
+ private:
+  std::tuple<Refs...> refs_;
+
+  template <class Tuple>
+  constexpr void assign(Tuple&& values) const {
+    [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+      ((std::get<I>(refs_) = std::get<I>(std::forward<Tuple>(values))), ...);
+    }(std::index_sequence_for<Refs...>{});
+  }
+};
+
+/**
+ * @brief Iterator over several sequences in lockstep, e.g. the arrays of a structure-of-arrays, which dereferences to a
+ * \ref zip_reference
+ *
+ * The iterator category is the weakest of the zipped iterators, so it is random access if all of them are. Two
+ * bidirectional zip iterators are equal if all of their components are equal, as equality has to be transitive when
+ * iterating backwards, so the end of a zipped sequence has to be computed in lockstep, e.g. as <code>first + n</code>
+ * like \ref zip does with the size of its shortest range. Forward zip iterators are equal if any of their components
+ * are equal, so a forward zipped sequence ends with its shortest component. The distance is the distance with the
+ * smallest magnitude. Sorting algorithms move and swap the elements of every component in place.
+ *
+ * @tparam Iters zipped iterators
+ */
+template <std::input_iterator... Iters>
+  requires(sizeof...(Iters) > 0)
+class zip_iterator : public iterator_facade<zip_iterator<Iters...>> {
+ public:
+  using reference = zip_reference<std::iter_reference_t<Iters>...>;
+  using value_type = typename reference::proxy_value_type;
+  using difference_type = std::common_type_t<std::iter_difference_t<Iters>...>;
+
+  constexpr zip_iterator() = default;
+  constexpr explicit zip_iterator(Iters... iters) noexcept((std::is_nothrow_move_constructible_v<Iters> && ...))
+      : iters_(std::move(iters)...) {}
+
+  [[nodiscard]] constexpr auto base() const noexcept -> std::tuple<Iters...> const& { return iters_; }
+
+  [[nodiscard]] constexpr auto dereference() const noexcept((nothrow_dereference<Iters> && ...)) -> reference {
+    return std::apply([](auto const&... iters) { return reference(*iters...); }, iters_);
+  }
+
+  constexpr void increment() noexcept((nothrow_increment<Iters> && ...)) {
+    std::apply([](auto&... iters) { (++iters, ...); }, iters_);
+  }
+
+  constexpr void decrement() noexcept((nothrow_decrement<Iters> && ...))
+    requires(std::bidirectional_iterator<Iters> && ...)
+  {
+    std::apply([](auto&... iters) { (--iters, ...); }, iters_);
+  }
+
+  constexpr void advance(difference_type n) noexcept((nothrow_advance<Iters> && ...))
+    requires(std::random_access_iterator<Iters> && ...)
+  {
+    std::apply([n](auto&... iters) { ((iters += static_cast<std::iter_difference_t<Iters>>(n)), ...); }, iters_);
+  }
+
+  [[nodiscard]] constexpr auto equals(zip_iterator const& other) const
+      noexcept((noexcept(std::declval<Iters const&>() == std::declval<Iters const&>()) && ...)) -> bool
+    requires(std::equality_comparable<Iters> && ...)
+  {
+    return [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+      if constexpr ((std::bidirectional_iterator<Iters> && ...)) {
+        return ((std::get<I>(iters_) == std::get<I>(other.iters_)) && ...);
+      } else {
+        return ((std::get<I>(iters_) == std::get<I>(other.iters_)) || ...);
+      }
+    }(std::index_sequence_for<Iters...>{});
+  }
+
+  [[nodiscard]] constexpr auto distance_to(zip_iterator const& other) const
+      noexcept((noexcept(std::declval<Iters const&>() - std::declval<Iters const&>()) && ...)) -> difference_type
+    requires(std::sized_sentinel_for<Iters, Iters> && ...)
+  {
+    return [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+      difference_type result = std::get<0>(other.iters_) - std::get<0>(iters_);
+      auto const magnitude = [](difference_type d) { return d < 0 ? -d : d; };
+      (
+          [&] {
+            difference_type const distance = std::get<I>(other.iters_) - std::get<I>(iters_);
+            if (magnitude(distance) < magnitude(result)) result = distance;
+          }(),
+          ...);
+      return result;
+    }(std::index_sequence_for<Iters...>{});
+  }
+
+  [[nodiscard]] constexpr auto iter_move() const
+      noexcept((noexcept(std::ranges::iter_move(std::declval<Iters const&>())) && ...) &&
+               std::is_nothrow_constructible_v<value_type, std::iter_rvalue_reference_t<Iters>...>) -> value_type {
+    return std::apply([](auto const&... iters) { return value_type(std::ranges::iter_move(iters)...); }, iters_);
+  }
+
+  constexpr void iter_swap(zip_iterator const& other) const
+      noexcept((noexcept(std::ranges::iter_swap(std::declval<Iters const&>(), std::declval<Iters const&>())) && ...)) {
+    [&]<std::size_t... I>(std::index_sequence<I...> /*unused*/) {
+      (std::ranges::iter_swap(std::get<I>(iters_), std::get<I>(other.iters_)), ...);
+    }(std::index_sequence_for<Iters...>{});
+  }
+
+ private:
+  std::tuple<Iters...> iters_;
+};
+
+/**
+ * @brief Zip random access ranges, the result is as long as the shortest range
+ *
+ * @return std::ranges::subrange<zip_iterator<std::ranges::iterator_t<Rs>...>>
+ */
+template <std::ranges::random_access_range... Rs>
+  requires((std::ranges::sized_range<Rs> && std::ranges::borrowed_range<Rs>) && ...)
+[[nodiscard]] constexpr auto zip(Rs&&... ranges) -> std::ranges::subrange<zip_iterator<std::ranges::iterator_t<Rs>...>> {
+  using iterator = zip_iterator<std::ranges::iterator_t<Rs>...>;
+  using difference_type = std::iter_difference_t<iterator>;
+  auto const size = std::min({static_cast<difference_type>(std::ranges::size(ranges))...});
+  iterator const first(std::ranges::begin(ranges)...);
+  return {first, first + size};
+}
+
+/** @} */  // end of zip
+
+}  // namespace ITERATOR_FACADE_NS
+
+template <class... Refs>
+struct std::tuple_size<ITERATOR_FACADE_NS::zip_reference<Refs...>>
+    : std::integral_constant<std::size_t, sizeof...(Refs)> {};
+
+template <std::size_t I, class... Refs>
+struct std::tuple_element<I, ITERATOR_FACADE_NS::zip_reference<Refs...>> {
+  using type = std::tuple_element_t<I, std::tuple<Refs...>>;
+};
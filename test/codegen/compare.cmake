@@ -0,0 +1,122 @@
+# Compares the assembly of every facade_<kernel> function against its pointer_<kernel> counterpart.
+#
+# Usage: cmake -DASSEMBLY=<file.s> [-DLOOP_TOLERANCE=<percent>] -P compare.cmake
+#
+# For every function the number of instructions, the length of the innermost loop (the shortest span closed by a
+# backward jump), calls (including tail calls) and stack accesses (push/pop and anything addressing the stack pointer,
+# i.e. spills) are counted. The facade version fails if its innermost loop is longer or it emits more calls or stack
+# accesses than the pointer version. Kernels without loops must not emit a single instruction more. Block layout
+# around loops can differ between the two versions even when the loops are identical, so kernels with loops may grow
+# by LOOP_TOLERANCE percent of the pointer version's innermost loop.
+#
+# Gaps which cannot be closed in the facade are listed in known_gaps as <kernel>=<instructions> and allowed exactly
+# that many extra instructions, a kernel whose gap shrinks is reported so that the entry can be tightened.
+
+cmake_minimum_required(VERSION 3.15)
+
+if(NOT DEFINED ASSEMBLY)
+  message(FATAL_ERROR "ASSEMBLY must be set to the assembly file to check")
+endif()
+if(NOT DEFINED LOOP_TOLERANCE)
+  set(LOOP_TOLERANCE 50)
+endif()
+
+# measured with GCC 12 on x86-64 at -O2 and -O3:
+# - less: distance_to(right) > 0 lowers to sub and test, the pointer comparison to a single cmp
+# - ranges_find: GCC threads the loop exit into separate returns for a class holding a pointer, with or without the
+#   facade, while the loop itself is identical
+set(known_gaps less=1 ranges_find=6)
+
+file(STRINGS "${ASSEMBLY}" lines)
+
+set(functions)
+set(function)
+foreach(line IN LISTS lines)
+  if(line MATCHES "^_?((pointer|facade)_[A-Za-z0-9_]+):")
+    set(function ${CMAKE_MATCH_1})
+    list(APPEND functions ${function})
+    set(${function}_instructions 0)
+    set(${function}_loop 0)
+    set(${function}_calls 0)
+    set(${function}_stack 0)
+    set(labels)
+  elseif(NOT function)
+    continue()
+  elseif(line MATCHES "^[ \t]*\\.(size|cfi_endproc)" OR line MATCHES "^L?\\.?Lfunc_end")
+    set(function)
+  elseif(line MATCHES "^([.A-Za-z0-9_$]+):")
+    list(APPEND labels ${CMAKE_MATCH_1})
+    set(label_${CMAKE_MATCH_1} ${${function}_instructions})
+  elseif(line MATCHES "^[ \t]+([a-z][a-z0-9.]*)")
+    set(mnemonic ${CMAKE_MATCH_1})
+    math(EXPR ${function}_instructions "${${function}_instructions} + 1")
+    # backward jumps close a loop
+    if(line MATCHES "^[ \t]+(j[a-z]*|b[a-z.]*)[ \t]+([.A-Za-z0-9_$]+)$")
+      set(target ${CMAKE_MATCH_2})
+      if(target IN_LIST labels)
+        math(EXPR length "${${function}_instructions} - ${label_${target}}")
+        if(${function}_loop EQUAL 0 OR length LESS ${function}_loop)
+          set(${function}_loop ${length})
+        endif()
+      endif()
+    endif()
+    # direct calls or jumps to non-local symbols, indirect calls
+    if(mnemonic MATCHES "^(call|bl|blr)" OR line MATCHES "^[ \t]+(jmp|b)[a-z]*[ \t]+[A-Za-z_]")
+      math(EXPR ${function}_calls "${${function}_calls} + 1")
+    endif()
+    if(mnemonic MATCHES "^(push|pop)" OR line MATCHES "%[re]?sp|[ \t,\\[]sp[],]")
+      math(EXPR ${function}_stack "${${function}_stack} + 1")
+    endif()
+  endif()
+endforeach()
+
+set(failed)
+set(checked 0)
+foreach(function IN LISTS functions)
+  if(NOT function MATCHES "^facade_(.+)$")
+    continue()
+  endif()
+  set(kernel ${CMAKE_MATCH_1})
+  set(baseline pointer_${kernel})
+  if(NOT DEFINED ${baseline}_instructions)
+    list(APPEND failed "${kernel}: missing ${baseline}")
+    continue()
+  endif()
+  math(EXPR checked "${checked} + 1")
+
+  set(summary
+      "${kernel}: ${${function}_instructions} vs ${${baseline}_instructions} instructions, ${${function}_loop} vs ${${baseline}_loop} in innermost loop, ${${function}_calls} vs ${${baseline}_calls} calls, ${${function}_stack} vs ${${baseline}_stack} stack accesses"
+  )
+  message(STATUS "${summary}")
+
+  set(gap 0)
+  if(${baseline}_loop GREATER 0)
+    math(EXPR gap "${${baseline}_loop} * ${LOOP_TOLERANCE} / 100")
+  endif()
+  foreach(known IN LISTS known_gaps)
+    if(known MATCHES "^${kernel}=([0-9]+)$")
+      set(gap ${CMAKE_MATCH_1})
+      math(EXPR measured "${${function}_instructions} - ${${baseline}_instructions}")
+      if(measured LESS gap)
+        message(STATUS "${kernel}: known gap of ${gap} instructions is now ${measured}, update known_gaps")
+      endif()
+    endif()
+  endforeach()
+
+  math(EXPR allowed "${${baseline}_instructions} + ${gap}")
+  if(${function}_instructions GREATER allowed
+     OR ${function}_loop GREATER ${baseline}_loop
+     OR ${function}_calls GREATER ${baseline}_calls
+     OR ${function}_stack GREATER ${baseline}_stack)
+    list(APPEND failed "${summary}")
+  endif()
+endforeach()
+
+if(checked EQUAL 0)
+  message(FATAL_ERROR "No facade_* kernels found in ${ASSEMBLY}")
+endif()
+
+if(failed)
+  list(JOIN failed "\n  " failed)
+  message(FATAL_ERROR "Facade iterators generated worse code than raw pointers:\n  ${failed}")
+endif()
@@ -0,0 +1,184 @@
+// Kernels compiled to assembly by the codegen tests. Every kernel is instantiated twice with the same C signature,
+// once over a raw pointer (pointer_<name>) and once over an iterator_facade wrapping that pointer (facade_<name>), and
+// compare.cmake checks that the facade version does not emit more instructions, calls or stack accesses.
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include <iterator_facade/algorithm.hpp>
+#include <iterator_facade/iterator_facade.hpp>
+#include <iterator_facade/prefetching_iterator.hpp>
+#include <iterator_facade/strided_iterator.hpp>
+
+namespace {
+
+struct contiguous : iterator_facade::iterator_facade<contiguous, true> {
+  using Iter = int const*;
+  using reference = std::iter_reference_t<Iter>;
+  using difference_type = std::iter_difference_t<Iter>;
+
+  Iter ptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> reference { return *ptr; }
+  constexpr void increment() noexcept { ++ptr; }
+  [[nodiscard]] constexpr auto equals(contiguous rhs) const noexcept -> bool { return ptr == rhs.ptr; }
+  constexpr void decrement() noexcept { --ptr; }
+  [[nodiscard]] constexpr auto distance_to(contiguous rhs) const noexcept -> difference_type { return rhs.ptr - ptr; }
+  constexpr void advance(difference_type delta) noexcept { ptr += delta; }
+};
+
+// contiguous only through its to_address() hook
+template <class T>
+struct addressed : iterator_facade::iterator_facade<addressed<T>> {
+  using difference_type = std::ptrdiff_t;
+
+  T* ptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> T& { return *ptr; }
+  [[nodiscard]] constexpr auto to_address() const noexcept -> T* { return ptr; }
+  [[nodiscard]] constexpr auto distance_to(addressed rhs) const noexcept -> difference_type { return rhs.ptr - ptr; }
+  constexpr void advance(difference_type delta) noexcept { ptr += delta; }
+};
+
+template <class It>
+auto sum(It first, It last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  std::ptrdiff_t result = 0;
+  for (; first != last; ++first) result += *first;
+  return result;
+}
+
+template <class It>
+auto sum_postfix(It first, It last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  std::ptrdiff_t result = 0;
+  while (first != last) result += *first++;
+  return result;
+}
+
+template <class It>
+auto sum_reverse(It first, It last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  std::ptrdiff_t result = 0;
+  while (last != first) result += *--last;
+  return result;
+}
+
+template <class It>
+auto subscript(It first, It /*unused*/, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return first[n];
+}
+
+template <class It>
+auto plus(It first, It /*unused*/, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return *(first + n);
+}
+
+template <class It>
+auto plus_assign(It first, It /*unused*/, std::ptrdiff_t n) -> std::ptrdiff_t {
+  first += n;
+  return *first;
+}
+
+template <class It>
+auto minus(It /*unused*/, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return *(last - n);
+}
+
+template <class It>
+auto minus_assign(It /*unused*/, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  last -= n;
+  return *last;
+}
+
+template <class It>
+auto distance(It first, It last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  return last - first;
+}
+
+template <class It>
+auto less(It first, It last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  return first < last ? 1 : 0;
+}
+
+template <class It>
+auto find(It first, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return std::find(first, last, static_cast<int>(n)) - first;
+}
+
+template <class It>
+auto ranges_find(It first, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return std::ranges::find(first, last, static_cast<int>(n)) - first;
+}
+
+template <class It>
+auto lower_bound(It first, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return std::lower_bound(first, last, static_cast<int>(n)) - first;
+}
+
+template <class It>
+auto ranges_lower_bound(It first, It last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  return std::ranges::lower_bound(first, last, static_cast<int>(n)) - first;
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define ITERF_CODEGEN_KERNEL(name)                                                                         \
+  extern "C" auto pointer_##name(int const* first, int const* last, std::ptrdiff_t n) -> std::ptrdiff_t { \
+    return name(first, last, n);                                                                           \
+  }                                                                                                        \
+  extern "C" auto facade_##name(int const* first, int const* last, std::ptrdiff_t n) -> std::ptrdiff_t {  \
+    return name(contiguous{{}, first}, contiguous{{}, last}, n);                                           \
+  }
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+ITERF_CODEGEN_KERNEL(sum)
+ITERF_CODEGEN_KERNEL(sum_postfix)
+ITERF_CODEGEN_KERNEL(sum_reverse)
+ITERF_CODEGEN_KERNEL(subscript)
+ITERF_CODEGEN_KERNEL(plus)
+ITERF_CODEGEN_KERNEL(plus_assign)
+ITERF_CODEGEN_KERNEL(minus)
+ITERF_CODEGEN_KERNEL(minus_assign)
+ITERF_CODEGEN_KERNEL(distance)
+ITERF_CODEGEN_KERNEL(less)
+ITERF_CODEGEN_KERNEL(find)
+ITERF_CODEGEN_KERNEL(ranges_find)
+ITERF_CODEGEN_KERNEL(lower_bound)
+ITERF_CODEGEN_KERNEL(ranges_lower_bound)
+
+// sum of n elements with a compile time stride, the scaling has to fold into the addressing like p[i * 4]
+extern "C" auto pointer_strided_sum(int const* first, int const* /*unused*/, std::ptrdiff_t n) -> std::ptrdiff_t {
+  std::ptrdiff_t result = 0;
+  for (auto const* const last = first + n * 4; first != last; first += 4) result += *first;
+  return result;
+}
+extern "C" auto facade_strided_sum(int const* first, int const* /*unused*/, std::ptrdiff_t n) -> std::ptrdiff_t {
+  auto const column = iterator_facade::strided<4>(first, n);
+  return sum(column.begin(), column.end(), n);
+}
+
+// sum with a prefetch 16 elements ahead, the adaptor has to compile to the hand written prefetch
+extern "C" auto pointer_prefetch_sum(int const* first, int const* last, std::ptrdiff_t /*unused*/) -> std::ptrdiff_t {
+  std::ptrdiff_t result = 0;
+  while (first != last) {
+    result += *first;
+    ++first;
+    if (last - first > 16) __builtin_prefetch(first + 16);
+  }
+  return result;
+}
+extern "C" auto facade_prefetch_sum(int const* first, int const* last, std::ptrdiff_t n) -> std::ptrdiff_t {
+  using iterator = iterator_facade::prefetching_iterator<int const*, 16>;
+  return sum(iterator(first, last), iterator(last, last), n);
+}
+
+// byte copies of contiguous iterators have to become the same memmove as pointer copies
+extern "C" auto pointer_copy_bytes(unsigned char const* first, unsigned char const* last, unsigned char* out)
+    -> unsigned char* {
+  return std::copy(first, last, out);
+}
+extern "C" auto facade_copy_bytes(unsigned char const* first, unsigned char const* last, unsigned char* out)
+    -> unsigned char* {
+  using input = addressed<unsigned char const>;
+  return iterator_facade::copy(input{{}, first}, input{{}, last}, addressed<unsigned char>{{}, out}).ptr;
+}
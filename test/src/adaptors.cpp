@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/adaptors.hpp>
+#include <iterator_facade/strided_iterator.hpp>
+
+namespace iterator_facade {
+
+TEST_CASE("Adaptor concepts", "[adaptors]") {
+  auto square = [](int value) noexcept { return value * value; };
+  auto odd = [](int value) { return value % 2 != 0; };
+  using transform = transform_iterator<int*, decltype(square)>;
+  using filter = filter_iterator<int*, int*, decltype(odd)>;
+
+  STATIC_REQUIRE(std::random_access_iterator<transform>);
+  STATIC_REQUIRE(std::sized_sentinel_for<transform, transform>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<transform>, int>);
+  STATIC_REQUIRE(std::bidirectional_iterator<filter>);
+  STATIC_REQUIRE_FALSE(std::random_access_iterator<filter>);
+  STATIC_REQUIRE(std::sentinel_for<std::default_sentinel_t, filter>);
+  STATIC_REQUIRE(std::forward_iterator<filter_iterator<std::forward_list<int>::iterator,
+                                                       std::forward_list<int>::iterator, decltype(odd)>>);
+  STATIC_REQUIRE(nothrow_dereference<transform>);
+  STATIC_REQUIRE(nothrow_advance<transform>);
+
+  // stateless functors take no space
+  STATIC_REQUIRE(sizeof(transform) == sizeof(int*));
+  STATIC_REQUIRE(sizeof(filter) == 2 * sizeof(int*));
+
+  // capturing lambdas are not assignable, the iterator still is
+  int offset = 1;
+  auto const shifted = [offset](int value) { return value + offset; };
+  STATIC_REQUIRE(std::random_access_iterator<transform_iterator<int*, decltype(shifted)>>);
+}
+
+TEST_CASE("Adaptors transform and filter ranges", "[adaptors]") {
+  std::vector<int> values{1, 2, 3, 4, 5, 6, 7, 8};
+  auto const square = [](int value) { return value * value; };
+  auto const odd = [](int value) { return value % 2 != 0; };
+
+  SECTION("transform") {
+    auto const range = transformed(values, square);
+    REQUIRE(std::ranges::equal(range, std::array{1, 4, 9, 16, 25, 36, 49, 64}));
+    REQUIRE(std::ranges::size(range) == 8);
+    REQUIRE(range.begin()[3] == 16);
+    REQUIRE(range.begin().base() == values.begin());
+  }
+
+  SECTION("filter") {
+    auto const range = filtered(values, odd);
+    REQUIRE(std::ranges::equal(range, std::array{1, 3, 5, 7}));
+    auto it = std::ranges::next(range.begin(), 3);
+    REQUIRE(*it == 7);
+    REQUIRE(*--it == 5);
+    REQUIRE(std::ranges::equal(filtered(values, [](int) { return false; }), std::array<int, 0>{}));
+  }
+
+  SECTION("lvalue references are preserved") {
+    struct point {
+      int x;
+      int y;
+    };
+    std::array<point, 3> points{{{1, 2}, {3, 4}, {5, 6}}};
+    auto const xs = transformed(points, &point::x);
+    STATIC_REQUIRE(std::same_as<std::ranges::range_reference_t<decltype(xs)>, int&>);
+    std::ranges::fill(xs, 0);
+    REQUIRE(points[1].x == 0);
+    REQUIRE(points[1].y == 4);
+  }
+
+  SECTION("stateful functors") {
+    int offset = 10;
+    auto const shifted = transformed(values, [offset](int value) { return value + offset; });
+    auto it = shifted.begin();
+    auto copy = it;
+    copy = std::ranges::next(it, 2);
+    REQUIRE(*copy == 13);
+    REQUIRE(std::ranges::equal(filtered(shifted, [offset](int value) { return value > offset + 6; }),
+                               std::array{17, 18}));
+  }
+
+  SECTION("sentinels") {
+    std::string text = "a,b";
+    auto const upper = transformed(std::ranges::subrange(text.begin(), std::unreachable_sentinel),
+                                   [](char c) { return static_cast<char>(c - 'a' + 'A'); });
+    STATIC_REQUIRE(std::same_as<std::ranges::sentinel_t<decltype(upper)>, std::unreachable_sentinel_t>);
+    REQUIRE(upper.begin()[2] == 'B');
+  }
+}
+
+TEST_CASE("Stacked adaptors are flattened", "[adaptors]") {
+  std::vector<int> values(20);
+  std::iota(values.begin(), values.end(), 0);
+  auto const square = [](int value) { return value * value; };
+  auto const negate = [](int value) { return -value; };
+  auto const odd = [](int value) { return value % 2 != 0; };
+  auto const small = [](int value) { return value < 100; };
+  auto const not_three = [](int value) { return value != 3; };
+
+  SECTION("transform of a transform") {
+    auto const range = transformed(transformed(values, square), negate);
+    STATIC_REQUIRE(sizeof(range.begin()) == sizeof(int*));
+    STATIC_REQUIRE(std::same_as<decltype(range.begin().base()), std::vector<int>::iterator const&>);
+    REQUIRE(range.begin()[3] == -9);
+    REQUIRE(std::ranges::size(range) == 20);
+  }
+
+  SECTION("filter of a filter") {
+    auto const range = filtered(filtered(values, odd), not_three);
+    STATIC_REQUIRE(sizeof(range.begin()) == 2 * sizeof(int*));
+    STATIC_REQUIRE(std::same_as<decltype(range.begin().base()), std::vector<int>::iterator const&>);
+    REQUIRE(std::ranges::equal(range, std::array{1, 5, 7, 9, 11, 13, 15, 17, 19}));
+  }
+
+  SECTION("filter pushed below a transform") {
+    auto const range = filtered(transformed(values, square), small);
+    using iterator = decltype(range.begin());
+    STATIC_REQUIRE(_ifacade_detail::is_transform_iterator<iterator>);
+    STATIC_REQUIRE(_ifacade_detail::is_filter_iterator<iterator::iterator_type>);
+    STATIC_REQUIRE(sizeof(iterator) == 2 * sizeof(int*));
+    REQUIRE(std::ranges::equal(range, std::array{0, 1, 4, 9, 16, 25, 36, 49, 64, 81}));
+  }
+
+  SECTION("transform over filter over transform over filter") {
+    auto const range = transformed(filtered(transformed(filtered(values, odd), square), small), negate);
+    using iterator = decltype(range.begin());
+    // one base iterator, one end bound
+    STATIC_REQUIRE(std::same_as<iterator::iterator_type::iterator_type, std::vector<int>::iterator>);
+    STATIC_REQUIRE(sizeof(iterator) == 2 * sizeof(int*));
+    REQUIRE(std::ranges::equal(range, std::array{-1, -9, -25, -49, -81}));
+
+    std::list<int> list(values.begin(), values.end());
+    auto const bidirectional = transformed(filtered(transformed(filtered(list, odd), square), small), negate);
+    STATIC_REQUIRE(std::bidirectional_iterator<decltype(bidirectional.begin())>);
+    REQUIRE(std::ranges::equal(bidirectional, range));
+  }
+
+  SECTION("stateful functors are stored once") {
+    int offset = 100;
+    auto const shifted = [offset](int value) { return value + offset; };
+    auto const range = filtered(transformed(values, shifted), [](int value) { return value % 5 == 0; });
+    using iterator = decltype(range.begin());
+    // the transform reads the functor from the predicate of the filter below it
+    STATIC_REQUIRE(sizeof(iterator) == sizeof(iterator::iterator_type));
+    REQUIRE(std::ranges::equal(range, std::array{100, 105, 110, 115}));
+    REQUIRE(range.begin().function()(1) == 101);
+
+    auto const below = [](int value) { return value < 104; };
+    auto const fused = filtered(filtered(transformed(values, shifted), below), [](int value) { return value > 100; });
+    STATIC_REQUIRE(sizeof(fused.begin()) == sizeof(decltype(fused.begin())::iterator_type));
+    REQUIRE(std::ranges::equal(transformed(fused, negate), std::array{-101, -102, -103}));
+  }
+
+  SECTION("transform over filter over strided") {
+    auto const evens = strided<2>(values.begin(), 10);
+    auto const range = transformed(filtered(evens, [](int value) { return value % 3 == 0; }), square);
+    STATIC_REQUIRE(sizeof(range.begin()) == 2 * sizeof(evens.begin()));
+    REQUIRE(std::ranges::equal(range, std::array{0, 36, 144, 324}));
+  }
+}
+
+TEST_CASE("Adaptors in constant expressions", "[adaptors]") {
+  constexpr auto sum = [] {
+    std::array values{1, 2, 3, 4, 5, 6};
+    int result = 0;
+    auto const even = [](int v) { return v % 2 == 0; };
+    for (int const value : transformed(filtered(values, even), [](int v) { return v * 10; })) result += value;
+    return result;
+  }();
+  STATIC_REQUIRE(sum == 120);
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,444 @@
+#include <array>
+#include <forward_list>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/algorithm.hpp>
+
+namespace iterf = iterator_facade;
+
+namespace iterator_facade {
+
+// deque-like storage: a sequence of non-empty chunks of different sizes
+using chunk = std::vector<int>;
+
+class chunked_iterator : public iterator_facade<chunked_iterator> {
+ public:
+  using value_type = int;
+
+  constexpr chunked_iterator() noexcept = default;
+  constexpr chunked_iterator(chunk* segment, chunk* last_segment, int* local) noexcept
+      : segment_(segment), last_segment_(last_segment), local_(local) {}
+
+  [[nodiscard]] static auto begin(std::vector<chunk>& chunks) noexcept -> chunked_iterator {
+    return {chunks.data(), &chunks.back(), chunks.front().data()};
+  }
+  [[nodiscard]] static auto end(std::vector<chunk>& chunks) noexcept -> chunked_iterator {
+    return {&chunks.back(), &chunks.back(), chunks.back().data() + chunks.back().size()};
+  }
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int& { return *local_; }
+  constexpr void increment() noexcept {
+    ++local_;
+    normalize();
+  }
+  [[nodiscard]] constexpr auto equals(chunked_iterator const& rhs) const noexcept -> bool {
+    return local_ == rhs.local_;
+  }
+
+  [[nodiscard]] constexpr auto segment() const noexcept -> chunk* { return segment_; }
+  [[nodiscard]] constexpr auto local() const noexcept -> int* { return local_; }
+  [[nodiscard]] constexpr static auto segment_begin(chunk* segment) noexcept -> int* { return segment->data(); }
+  [[nodiscard]] constexpr static auto segment_end(chunk* segment) noexcept -> int* {
+    return segment->data() + segment->size();
+  }
+  [[nodiscard]] constexpr auto compose(chunk* segment, int* local) const noexcept -> chunked_iterator {
+    chunked_iterator it{segment, last_segment_, local};
+    it.normalize();
+    return it;
+  }
+
+ private:
+  chunk* segment_ = nullptr;
+  chunk* last_segment_ = nullptr;
+  int* local_ = nullptr;
+
+  // the end of a chunk is the beginning of the next one, unless it is the last chunk
+  constexpr void normalize() noexcept {
+    if (segment_ != last_segment_ && local_ == segment_end(segment_)) {
+      ++segment_;
+      local_ = segment_begin(segment_);
+    }
+  }
+};
+
+TEST_CASE("Segmented iterator protocol", "[segmented]") {
+  STATIC_REQUIRE(std::forward_iterator<chunked_iterator>);
+  STATIC_REQUIRE(segmented_iterator<chunked_iterator>);
+  STATIC_REQUIRE(std::same_as<segment_iterator_t<chunked_iterator>, chunk*>);
+  STATIC_REQUIRE(std::same_as<local_iterator_t<chunked_iterator>, int*>);
+  STATIC_REQUIRE_FALSE(segmented_iterator<int*>);
+  STATIC_REQUIRE_FALSE(segmented_iterator<std::vector<int>::iterator>);
+}
+
+TEST_CASE("Segmented algorithms", "[segmented][algorithms]") {
+  std::vector<chunk> chunks{{1, 2, 3}, {4}, {5, 6, 7, 8}, {9, 10}};
+  auto const first = chunked_iterator::begin(chunks);
+  auto const last = chunked_iterator::end(chunks);
+  constexpr std::array expected{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  REQUIRE(std::ranges::equal(first, last, expected.begin(), expected.end()));
+
+  SECTION("for_each") {
+    std::vector<int> visited;
+    iterf::for_each(first, last, [&](int value) { visited.push_back(value); });
+    REQUIRE(std::ranges::equal(visited, expected));
+
+    visited.clear();
+    iterf::for_each(std::next(first, 4), std::next(first, 5), [&](int value) { visited.push_back(value); });
+    REQUIRE(visited == std::vector<int>{5});
+  }
+
+  SECTION("copy") {
+    std::array<int, expected.size()> output{};
+    REQUIRE(iterf::copy(first, last, output.begin()) == output.end());
+    REQUIRE(output == expected);
+
+    std::vector<int> partial;
+    iterf::copy(std::next(first, 2), std::next(first, 7), std::back_inserter(partial));
+    REQUIRE(partial == std::vector<int>{3, 4, 5, 6, 7});
+  }
+
+  SECTION("fill") {
+    REQUIRE(iterf::fill(std::next(first), std::next(first, 9), 0) == std::next(first, 9));
+    REQUIRE(chunks == std::vector<chunk>{{1, 0, 0}, {0}, {0, 0, 0, 0}, {0, 10}});
+  }
+
+  SECTION("find") {
+    for (int value : expected) {
+      auto const found = iterf::find(first, last, value);
+      REQUIRE(found != last);
+      REQUIRE(*found == value);
+      REQUIRE(found == std::ranges::find(first, last, value));
+    }
+    REQUIRE(iterf::find(first, last, 42) == last);
+    REQUIRE(iterf::find(std::next(first, 5), last, 2) == last);
+    REQUIRE(iterf::find(first, std::next(first, 3), 4) == std::next(first, 3));
+  }
+
+  SECTION("accumulate") {
+    REQUIRE(iterf::accumulate(first, last, 0) == 55);
+    REQUIRE(iterf::accumulate(std::next(first, 3), std::next(first, 6), 1, std::multiplies<>{}) == 120);
+  }
+}
+
+// computed input iterator which decodes values one at a time or a block at a time into an internal buffer
+class decoding_iterator : public iterator_facade<decoding_iterator> {
+ public:
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+
+  struct statistics {
+    int dereferences = 0;
+    int blocks = 0;
+  };
+
+  decoding_iterator() = default;
+  decoding_iterator(difference_type size, statistics* stats) noexcept : size_(size), stats_(stats) {}
+
+  [[nodiscard]] auto dereference() const noexcept -> int {
+    ++stats_->dereferences;
+    return decode(position_);
+  }
+  void increment() noexcept { ++position_; }
+  [[nodiscard]] auto equals(std::default_sentinel_t /*unused*/) const noexcept -> bool { return position_ == size_; }
+
+  [[nodiscard]] auto next_block(difference_type n) noexcept -> std::span<int const> {
+    ++stats_->blocks;
+    auto const count = std::min({n, size_ - position_, static_cast<difference_type>(buffer_.size())});
+    for (difference_type i = 0; i < count; ++i) buffer_[static_cast<std::size_t>(i)] = decode(position_ + i);
+    position_ += count;
+    return {buffer_.data(), static_cast<std::size_t>(count)};
+  }
+
+ private:
+  difference_type position_ = 0;
+  difference_type size_ = 0;
+  statistics* stats_ = nullptr;
+  std::array<int, 16> buffer_{};
+
+  [[nodiscard]] constexpr static auto decode(difference_type i) noexcept -> int { return static_cast<int>(i * i); }
+};
+
+// random access iterator which hands out blocks of the underlying array
+class array_block_iterator : public iterator_facade<array_block_iterator> {
+ public:
+  using difference_type = std::ptrdiff_t;
+
+  constexpr array_block_iterator() noexcept = default;
+  constexpr explicit array_block_iterator(int const* ptr) noexcept : ptr_(ptr) {}
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return *ptr_; }
+  constexpr void advance(difference_type n) noexcept { ptr_ += n; }
+  [[nodiscard]] constexpr auto distance_to(array_block_iterator rhs) const noexcept -> difference_type {
+    return rhs.ptr_ - ptr_;
+  }
+
+  [[nodiscard]] constexpr auto next_block(difference_type n) noexcept -> std::span<int const> {
+    std::span<int const> block{ptr_, static_cast<std::size_t>(n)};
+    ptr_ += n;
+    return block;
+  }
+
+ private:
+  int const* ptr_ = nullptr;
+};
+
+TEST_CASE("Block iterators", "[block][algorithms]") {
+  STATIC_REQUIRE(block_iterator<decoding_iterator>);
+  STATIC_REQUIRE(std::input_iterator<decoding_iterator>);
+  STATIC_REQUIRE(std::sentinel_for<std::default_sentinel_t, decoding_iterator>);
+  STATIC_REQUIRE(block_iterator<array_block_iterator>);
+  STATIC_REQUIRE_FALSE(block_iterator<int const*>);
+
+  SECTION("end of sequence sentinel") {
+    constexpr std::ptrdiff_t size = 100;
+    decoding_iterator::statistics stats;
+    std::vector<int> expected(size);
+    for (std::size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<int>(i * i);
+
+    std::vector<int> visited;
+    iterf::for_each(decoding_iterator(size, &stats), std::default_sentinel,
+                    [&](int value) { visited.push_back(value); });
+    REQUIRE(visited == expected);
+    REQUIRE(stats.dereferences == 0);
+    REQUIRE(stats.blocks == 7);
+
+    std::vector<int> copied;
+    iterf::copy(decoding_iterator(size, &stats), std::default_sentinel, std::back_inserter(copied));
+    REQUIRE(copied == expected);
+
+    REQUIRE(iterf::accumulate(decoding_iterator(size, &stats), std::default_sentinel, 0) == 328350);
+    REQUIRE(stats.dereferences == 0);
+  }
+
+  SECTION("sized sentinel") {
+    constexpr std::array<int, 600> values = [] {
+      std::array<int, 600> result{};
+      for (std::size_t i = 0; i < result.size(); ++i) result[i] = static_cast<int>(i);
+      return result;
+    }();
+    array_block_iterator const first{values.data()};
+    array_block_iterator const last{values.data() + 550};
+
+    REQUIRE(iterf::accumulate(first, last, 0) == 550 * 549 / 2);
+    REQUIRE(iterf::accumulate(first + 10, first + 10, 0) == 0);
+
+    std::vector<int> copied;
+    iterf::copy(first + 5, first + 8, std::back_inserter(copied));
+    REQUIRE(copied == std::vector<int>{5, 6, 7});
+  }
+}
+
+TEST_CASE("Algorithms fall back for non-segmented iterators", "[algorithms]") {
+  std::vector<int> values{3, 1, 4, 1, 5};
+
+  REQUIRE(iterf::accumulate(values.begin(), values.end(), 0) == 14);
+  REQUIRE(iterf::find(values.begin(), values.end(), 4) == values.begin() + 2);
+  REQUIRE(iterf::find(values.begin(), std::unreachable_sentinel, 5) == values.begin() + 4);
+  REQUIRE(iterf::fill(values.begin(), values.begin() + 2, 7) == values.begin() + 2);
+  REQUIRE(values == std::vector<int>{7, 7, 4, 1, 5});
+
+  int sum = 0;
+  iterf::for_each(values.begin(), values.end(), [&](int value) { sum += value; });
+  REQUIRE(sum == 24);
+}
+
+// byte buffer iterator which is only contiguous through its to_address() hook
+class buffer_iterator : public iterator_facade<buffer_iterator> {
+ public:
+  using difference_type = std::ptrdiff_t;
+
+  constexpr buffer_iterator() noexcept = default;
+  constexpr explicit buffer_iterator(unsigned char* byte) noexcept : byte_(byte) {}
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> unsigned char& { return *byte_; }
+  [[nodiscard]] constexpr auto to_address() const noexcept -> unsigned char* { return byte_; }
+  constexpr void advance(difference_type n) noexcept { byte_ += n; }
+  [[nodiscard]] constexpr auto distance_to(buffer_iterator other) const noexcept -> difference_type {
+    return other.byte_ - byte_;
+  }
+
+ private:
+  unsigned char* byte_ = nullptr;
+};
+
+TEST_CASE("Contiguous algorithms work on raw pointers", "[contiguous][algorithms]") {
+  STATIC_REQUIRE(std::contiguous_iterator<buffer_iterator>);
+
+  std::array<unsigned char, 8> source{1, 2, 3, 4, 5, 6, 7, 8};
+  std::array<unsigned char, 8> target{};
+  buffer_iterator const first(source.data());
+  buffer_iterator const last(source.data() + source.size());
+  buffer_iterator const out(target.data());
+
+  SECTION("copy") {
+    REQUIRE(iterf::copy(first, last, out) == buffer_iterator(target.data() + target.size()));
+    REQUIRE(target == source);
+    REQUIRE(iterf::copy(first, first, out) == out);
+  }
+
+  SECTION("fill") {
+    REQUIRE(iterf::fill(out + 2, out + 6, static_cast<unsigned char>(9)) == out + 6);
+    REQUIRE(target == std::array<unsigned char, 8>{0, 0, 9, 9, 9, 9, 0, 0});
+  }
+
+  SECTION("equal") {
+    REQUIRE(!iterf::equal(first, last, out, out + 8));
+    iterf::copy(first, last, out);
+    REQUIRE(iterf::equal(first, last, out, out + 8));
+    REQUIRE(!iterf::equal(first, last, out, out + 7));
+    REQUIRE(iterf::equal(first, first, out, out));
+    REQUIRE(iterf::equal(first, last, source.begin(), source.end()));
+  }
+}
+
+// output iterator appending to a vector which counts single and batched writes
+class batch_writer : public iterator_facade<batch_writer> {
+ public:
+  using difference_type = std::ptrdiff_t;
+
+  struct sink {
+    std::vector<int> values;
+    int writes = 0;
+    std::vector<std::size_t> batches;
+  };
+
+  batch_writer() noexcept = default;
+  explicit batch_writer(sink* target) noexcept : sink_(target) {}
+
+  void write(int value) {
+    ++sink_->writes;
+    sink_->values.push_back(value);
+  }
+  void write_n(std::span<int const> values) {
+    sink_->batches.push_back(values.size());
+    sink_->values.insert(sink_->values.end(), values.begin(), values.end());
+  }
+
+ private:
+  sink* sink_ = nullptr;
+};
+
+TEST_CASE("Bulk output iterators", "[output][algorithms]") {
+  STATIC_REQUIRE(std::output_iterator<batch_writer, int>);
+  STATIC_REQUIRE(bulk_output_iterator<batch_writer, int>);
+  STATIC_REQUIRE_FALSE(bulk_output_iterator<batch_writer, long long>);
+  STATIC_REQUIRE_FALSE(bulk_output_iterator<std::back_insert_iterator<std::vector<int>>, int>);
+
+  batch_writer::sink sink;
+  batch_writer const out(&sink);
+  std::array<int, 600> values{};
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+
+  SECTION("copy of a contiguous range") {
+    iterf::copy(values.begin(), values.end(), out);
+    REQUIRE(std::ranges::equal(sink.values, values));
+    REQUIRE(sink.batches == std::vector<std::size_t>{600});
+    REQUIRE(sink.writes == 0);
+
+    iterf::copy(values.begin(), values.begin(), out);
+    REQUIRE(sink.batches.size() == 1);
+  }
+
+  SECTION("copy of segments and blocks") {
+    std::vector<chunk> chunks{{1, 2, 3}, {4}, {5, 6, 7, 8}};
+    iterf::copy(chunked_iterator::begin(chunks), chunked_iterator::end(chunks), out);
+    REQUIRE(sink.values == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+    REQUIRE(sink.batches == std::vector<std::size_t>{3, 1, 4});
+
+    sink = {};
+    decoding_iterator::statistics stats;
+    iterf::copy(decoding_iterator(20, &stats), std::default_sentinel, out);
+    REQUIRE(sink.values.size() == 20);
+    REQUIRE(sink.values[19] == 19 * 19);
+    REQUIRE(sink.batches == std::vector<std::size_t>{16, 4});
+    REQUIRE(sink.writes == 0);
+  }
+
+  SECTION("copy of other ranges writes one value at a time") {
+    std::forward_list<int> list{1, 2, 3};
+    iterf::copy(list.begin(), list.end(), out);
+    REQUIRE(sink.values == std::vector<int>{1, 2, 3});
+    REQUIRE(sink.writes == 3);
+    REQUIRE(sink.batches.empty());
+  }
+
+  SECTION("transform") {
+    iterf::transform(values.begin(), values.end(), out, [](int value) { return value * 2; });
+    REQUIRE(sink.values.size() == values.size());
+    REQUIRE(sink.values[599] == 1198);
+    REQUIRE(sink.batches == std::vector<std::size_t>{256, 256, 88});
+    REQUIRE(sink.writes == 0);
+
+    std::vector<int> doubled;
+    iterf::transform(values.begin(), values.begin() + 3, std::back_inserter(doubled), [](int value) { return -value; });
+    REQUIRE(doubled == std::vector<int>{0, -1, -2});
+  }
+}
+
+template <class Subranges>
+auto sizes(Subranges const& subranges) -> std::vector<std::ptrdiff_t> {
+  std::vector<std::ptrdiff_t> result;
+  for (auto const& subrange : subranges) result.push_back(std::ranges::distance(subrange));
+  return result;
+}
+
+TEST_CASE("Range partitioning", "[partitioning][algorithms]") {
+  constexpr std::array<int, 10> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  SECTION("split random access") {
+    array_block_iterator const first{values.data()};
+    array_block_iterator const last{values.data() + values.size()};
+
+    auto const parts = iterf::split(first, last, 4);
+    REQUIRE(sizes(parts) == std::vector<std::ptrdiff_t>{3, 3, 2, 2});
+    REQUIRE(parts.front().begin() == first);
+    REQUIRE(parts.back().end() == last);
+    for (std::size_t i = 1; i < parts.size(); ++i) REQUIRE(parts[i - 1].end() == parts[i].begin());
+
+    REQUIRE(sizes(iterf::split(first, last, 1)) == std::vector<std::ptrdiff_t>{10});
+    REQUIRE(sizes(iterf::split(first, first + 3, 8)) == std::vector<std::ptrdiff_t>{1, 1, 1});
+    REQUIRE(iterf::split(first, first, 4).empty());
+    REQUIRE(iterf::split(first, last, 0).empty());
+  }
+
+  SECTION("split forward") {
+    std::forward_list<int> list(values.begin(), values.end());
+
+    auto const parts = iterf::split(list.begin(), list.end(), 3);
+    REQUIRE(sizes(parts) == std::vector<std::ptrdiff_t>{4, 3, 3});
+    REQUIRE(*parts[1].begin() == 4);
+    REQUIRE(parts.back().end() == list.end());
+
+    // exact, too small and too large size hints
+    REQUIRE(sizes(iterf::split(list.begin(), list.end(), 3, 10)) == std::vector<std::ptrdiff_t>{4, 3, 3});
+    REQUIRE(sizes(iterf::split(list.begin(), list.end(), 3, 6)) == std::vector<std::ptrdiff_t>{2, 2, 6});
+    REQUIRE(sizes(iterf::split(list.begin(), list.end(), 3, 30)) == std::vector<std::ptrdiff_t>{10});
+    // non-positive hints are ignored and the range is counted
+    REQUIRE(sizes(iterf::split(list.begin(), list.end(), 3, 0)) == std::vector<std::ptrdiff_t>{4, 3, 3});
+    REQUIRE(sizes(iterf::split(list.begin(), list.end(), 3, -5)) == std::vector<std::ptrdiff_t>{4, 3, 3});
+
+    std::vector<chunk> chunks{{1, 2, 3}, {4}, {5, 6, 7, 8}, {9, 10}};
+    auto const segmented = iterf::split(chunked_iterator::begin(chunks), chunked_iterator::end(chunks), 2);
+    REQUIRE(sizes(segmented) == std::vector<std::ptrdiff_t>{5, 5});
+    REQUIRE(*segmented[1].begin() == 6);
+  }
+
+  SECTION("chunks_of") {
+    array_block_iterator const first{values.data()};
+    array_block_iterator const last{values.data() + values.size()};
+    REQUIRE(sizes(iterf::chunks_of(first, last, 4)) == std::vector<std::ptrdiff_t>{4, 4, 2});
+    REQUIRE(sizes(iterf::chunks_of(first, last, 5)) == std::vector<std::ptrdiff_t>{5, 5});
+    REQUIRE(sizes(iterf::chunks_of(first, last, 20)) == std::vector<std::ptrdiff_t>{10});
+    REQUIRE(iterf::chunks_of(first, last, 0).empty());
+
+    std::forward_list<int> list(values.begin(), values.end());
+    auto const parts = iterf::chunks_of(list.begin(), list.end(), 3);
+    REQUIRE(sizes(parts) == std::vector<std::ptrdiff_t>{3, 3, 3, 1});
+    REQUIRE(*parts.back().begin() == 9);
+  }
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/bit_iterator.hpp>
+
+namespace iterator_facade {
+
+TEST_CASE("Bit iterator concepts", "[bits]") {
+  using iterator = bit_iterator<std::uint64_t>;
+  using const_iterator = bit_iterator<std::uint64_t const>;
+
+  STATIC_REQUIRE(std::random_access_iterator<iterator>);
+  STATIC_REQUIRE(std::random_access_iterator<const_iterator>);
+  STATIC_REQUIRE(std::sortable<iterator>);
+  STATIC_REQUIRE(std::indirectly_writable<iterator, bool>);
+  STATIC_REQUIRE_FALSE(std::indirectly_writable<const_iterator, bool>);
+  STATIC_REQUIRE(proxy_reference<bit_reference<std::uint64_t>>);
+  STATIC_REQUIRE(std::same_as<std::iter_value_t<iterator>, bool>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<const_iterator>, bool>);
+  STATIC_REQUIRE(std::convertible_to<iterator, const_iterator>);
+  STATIC_REQUIRE_FALSE(std::convertible_to<const_iterator, iterator>);
+  STATIC_REQUIRE(nothrow_advance<iterator>);
+  STATIC_REQUIRE(nothrow_distance_to<iterator>);
+  STATIC_REQUIRE(sizeof(iterator) == 2 * sizeof(void*));
+}
+
+TEST_CASE("Bit iterator positions", "[bits]") {
+  std::array<std::uint64_t, 3> words{0b1011, 0, std::uint64_t{1} << 63U};
+  auto const range = bits(words);
+  auto const first = range.begin();
+
+  REQUIRE(std::ranges::size(range) == 192);
+  REQUIRE(bits(words, 70).size() == 70);
+  REQUIRE(first[0]);
+  REQUIRE(first[1]);
+  REQUIRE_FALSE(first[2]);
+  REQUIRE(first[3]);
+  REQUIRE(first[191]);
+
+  auto it = first + 130;
+  REQUIRE(it.word() == &words[2]);
+  REQUIRE(it.offset() == 2);
+  REQUIRE(it - first == 130);
+  REQUIRE(first - it == -130);
+  it -= 67;
+  REQUIRE(it.word() == &words[0]);
+  REQUIRE(it.offset() == 63);
+  REQUIRE(++it == first + 64);
+  REQUIRE(--it == first + 63);
+  REQUIRE((range.end() - 1).offset() == 63);
+
+  first[2] = true;
+  first[0] = false;
+  first[64].flip();
+  REQUIRE(words[0] == 0b1110);
+  REQUIRE(words[1] == 1);
+
+  std::ranges::sort(first, first + 8);
+  REQUIRE(words[0] == 0b1110'0000);
+}
+
+// compares the word-wise algorithms with bit-by-bit std algorithms for all offsets around word boundaries
+template <class Word>
+void check_word_algorithms() {
+  constexpr std::size_t word_count = 4;
+  constexpr auto word_bits = static_cast<std::ptrdiff_t>(bit_iterator<Word>::word_bits);
+  constexpr auto size = static_cast<std::ptrdiff_t>(word_count) * word_bits;
+
+  std::array<Word, word_count> words{};
+  for (std::size_t i = 0; i < word_count; ++i) words[i] = static_cast<Word>(0x9E3779B97F4A7C15ULL >> (i * 7));
+  bit_iterator<Word const> const first(words.data());
+
+  std::vector<std::ptrdiff_t> positions;
+  for (std::ptrdiff_t i = 0; i <= size; ++i) {
+    auto const offset = i % word_bits;
+    if (offset <= 2 || offset >= word_bits - 2 || i % 5 == 0) positions.push_back(i);
+  }
+
+  for (auto const begin : positions) {
+    for (auto const end : positions) {
+      if (end < begin) continue;
+      auto const b = first + begin;
+      auto const e = first + end;
+      INFO("bits [" << begin << ", " << end << ")");
+
+      for (bool const value : {false, true}) {
+        REQUIRE(count(b, e, value) == std::ranges::count(b, e, value));
+        REQUIRE(find(b, e, value) == std::ranges::find(b, e, value));
+        std::array const set{value};
+        REQUIRE(find_first_of(b, e, set.begin(), set.end()) ==
+                std::ranges::find_first_of(b, e, set.begin(), set.end()));
+
+        std::array<Word, word_count> filled = words;
+        std::vector<bool> expected(b, first + size);
+        std::fill(expected.begin(), expected.begin() + (end - begin), value);
+        bit_iterator<Word> const mutable_first(filled.data());
+        REQUIRE(fill(mutable_first + begin, mutable_first + end, value) == mutable_first + end);
+        REQUIRE(std::ranges::equal(mutable_first + begin, mutable_first + size, expected.begin(), expected.end()));
+        REQUIRE(std::ranges::equal(mutable_first, mutable_first + begin, first, b));
+      }
+    }
+  }
+
+  std::array<bool, 2> const both{false, true};
+  REQUIRE(find_first_of(first + 3, first + 9, both.begin(), both.end()) == first + 3);
+  REQUIRE(find_first_of(first + 3, first + 9, both.begin(), both.begin()) == first + 9);
+
+  // copies between all source and destination offsets of a word
+  for (std::ptrdiff_t from = 0; from < word_bits; ++from) {
+    for (std::ptrdiff_t to = 0; to < word_bits; ++to) {
+      for (std::ptrdiff_t const length : {std::ptrdiff_t{0}, std::ptrdiff_t{1}, word_bits - 1, word_bits,
+                                          2 * word_bits + 3}) {
+        INFO("copy " << length << " bits from " << from << " to " << to);
+        std::array<Word, word_count> target{};
+        std::fill(target.begin(), target.end(), static_cast<Word>(0xA5A5A5A5A5A5A5A5ULL));
+        auto const before = target;
+        bit_iterator<Word> const out(target.data());
+
+        REQUIRE(copy(first + from, first + from + length, out + to) == out + to + length);
+        REQUIRE(std::ranges::equal(out + to, out + to + length, first + from, first + from + length));
+        // bits outside of the destination are untouched
+        bit_iterator<Word const> const untouched(before.data());
+        REQUIRE(std::ranges::equal(out, out + to, untouched, untouched + to));
+        REQUIRE(std::ranges::equal(out + to + length, out + size, untouched + to + length, untouched + size));
+      }
+    }
+  }
+}
+
+TEST_CASE("Word-wise bit algorithms", "[bits][algorithms]") {
+  SECTION("64 bit words") { check_word_algorithms<std::uint64_t>(); }
+  SECTION("8 bit words") { check_word_algorithms<std::uint8_t>(); }
+}
+
+TEST_CASE("Word-wise bit algorithms in constant expressions", "[bits][algorithms]") {
+  constexpr auto ones = [] {
+    std::array<std::uint32_t, 4> words{};
+    auto const range = bits(words);
+    fill(range.begin() + 5, range.begin() + 100, true);
+    return count(range.begin(), range.end(), true);
+  }();
+  STATIC_REQUIRE(ones == 95);
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,123 @@
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/fd_record_reader.hpp>
+
+#if __has_include(<unistd.h>)
+
+namespace iterator_facade {
+
+// pipe which has been written and closed, so reading it ends at the written data
+class filled_pipe {
+ public:
+  explicit filled_pipe(std::string_view data) {
+    std::array<int, 2> fds{};
+    REQUIRE(::pipe(fds.data()) == 0);
+    read_ = fds[0];
+    REQUIRE(::write(fds[1], data.data(), data.size()) == static_cast<::ssize_t>(data.size()));
+    ::close(fds[1]);
+  }
+  filled_pipe(filled_pipe const&) = delete;
+  auto operator=(filled_pipe const&) -> filled_pipe& = delete;
+  ~filled_pipe() { ::close(read_); }
+
+  [[nodiscard]] auto fd() const noexcept -> int { return read_; }
+
+ private:
+  int read_ = -1;
+};
+
+template <class Reader>
+auto read_all(Reader& reader) -> std::vector<std::string> {
+  std::vector<std::string> records;
+  for (std::string_view const record : reader) records.emplace_back(record);
+  return records;
+}
+
+TEST_CASE("Record reader concepts", "[records]") {
+  using iterator = fd_record_reader<>::iterator;
+  STATIC_REQUIRE(std::input_iterator<iterator>);
+  STATIC_REQUIRE_FALSE(std::forward_iterator<iterator>);
+  STATIC_REQUIRE(std::sentinel_for<std::default_sentinel_t, iterator>);
+  STATIC_REQUIRE(std::ranges::input_range<fd_record_reader<>>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<iterator>, std::string_view>);
+  // postfix increment keeps a copy of the previous record, the buffer may be reused by then
+  STATIC_REQUIRE(std::same_as<std::remove_cvref_t<decltype(*std::declval<iterator&>()++)>, std::string>);
+}
+
+TEST_CASE("Record reader reads lines", "[records]") {
+  SECTION("complete lines") {
+    filled_pipe const pipe("first\nsecond\n\nlast\n");
+    fd_record_reader reader(pipe.fd());
+    REQUIRE(read_all(reader) == std::vector<std::string>{"first", "second", "", "last"});
+  }
+
+  SECTION("missing final delimiter") {
+    filled_pipe const pipe("a;bb;ccc");
+    fd_record_reader reader(pipe.fd(), line_framing{';'});
+    REQUIRE(read_all(reader) == std::vector<std::string>{"a", "bb", "ccc"});
+  }
+
+  SECTION("records larger than the buffer") {
+    std::string const long_line(100, 'x');
+    filled_pipe const pipe("short\n" + long_line + "\nend\n");
+    fd_record_reader reader(pipe.fd(), {}, {.buffer_size = 8});
+    REQUIRE(read_all(reader) == std::vector<std::string>{"short", long_line, "end"});
+    REQUIRE(reader.buffer_size() >= 101);
+  }
+
+  SECTION("postfix increment") {
+    filled_pipe const pipe("one\ntwo\n");
+    fd_record_reader reader(pipe.fd(), {}, {.buffer_size = 4});
+    auto it = reader.begin();
+    std::string const first = *it++;
+    REQUIRE(first == "one");
+    REQUIRE(*it == "two");
+    ++it;
+    REQUIRE(it == reader.end());
+  }
+
+  SECTION("empty input") {
+    filled_pipe const pipe("");
+    fd_record_reader reader(pipe.fd());
+    REQUIRE(reader.begin() == reader.end());
+  }
+}
+
+TEST_CASE("Record reader reads length prefixed frames", "[records]") {
+  auto const frame = [](std::string_view payload) {
+    auto const size = static_cast<std::uint16_t>(payload.size());
+    return std::string{static_cast<char>(size >> 8U), static_cast<char>(size & 0xFFU)} + std::string(payload);
+  };
+  using big_endian_frames = length_prefixed_framing<std::uint16_t, std::endian::big>;
+
+  SECTION("complete frames") {
+    std::string const binary("\0\x01z", 3);
+    filled_pipe const pipe(frame("hello") + frame("") + frame(binary) + frame(std::string(300, 'y')));
+    fd_record_reader reader(pipe.fd(), big_endian_frames{}, {.buffer_size = 16});
+    REQUIRE(read_all(reader) == std::vector<std::string>{"hello", "", binary, std::string(300, 'y')});
+  }
+
+  SECTION("truncated frame") {
+    filled_pipe const pipe(frame("hello") + frame("world").substr(0, 4));
+    fd_record_reader reader(pipe.fd(), big_endian_frames{});
+    auto it = reader.begin();
+    REQUIRE(*it == "hello");
+    REQUIRE_THROWS_AS(++it, std::runtime_error);
+  }
+}
+
+TEST_CASE("Record reader reports read errors", "[records]") {
+  fd_record_reader reader(-1);
+  REQUIRE_THROWS_AS(reader.begin(), std::system_error);
+}
+
+}  // namespace iterator_facade
+
+#endif
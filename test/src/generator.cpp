@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/generator.hpp>
+
+namespace iterator_facade {
+
+auto iota(int first, int last) -> generator<int> {
+  for (int i = first; i < last; ++i) co_yield i;
+}
+
+auto fibonacci() -> generator<long> {
+  long a = 0;
+  long b = 1;
+  while (true) {
+    co_yield a;
+    a = std::exchange(b, a + b);
+  }
+}
+
+auto elements(std::vector<int>& values) -> generator<int&> {
+  for (auto& value : values) co_yield value;
+}
+
+auto owners(int count) -> generator<std::unique_ptr<int>&&> {
+  for (int i = 0; i < count; ++i) co_yield std::make_unique<int>(i);
+}
+
+auto throwing(int count) -> generator<int> {
+  for (int i = 0; i < count; ++i) co_yield i;
+  throw std::runtime_error("done");
+}
+
+// allocator which counts the bytes it hands out, passed to coroutines with std::allocator_arg
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+
+  std::size_t* allocated;
+
+  explicit counting_allocator(std::size_t* counter) noexcept : allocated(counter) {}
+  template <class U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  counting_allocator(counting_allocator<U> const& other) noexcept : allocated(other.allocated) {}
+
+  auto allocate(std::size_t n) -> T* {
+    *allocated += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    *allocated -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  template <class U>
+  friend auto operator==(counting_allocator const& lhs, counting_allocator<U> const& rhs) noexcept -> bool {
+    return lhs.allocated == rhs.allocated;
+  }
+};
+
+// GCC 12 does not pair the allocator_arg operator new of the promise with its operator delete
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+auto counted_iota(std::allocator_arg_t /*unused*/, counting_allocator<std::byte> const& /*unused*/, int last)
+    -> generator<int, counting_allocator<std::byte>> {
+  for (int i = 0; i < last; ++i) co_yield i;
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#  pragma GCC diagnostic pop
+#endif
+
+auto pooled_iota(int last) -> pooled_generator<int> {
+  for (int i = 0; i < last; ++i) co_yield i;
+}
+
+TEST_CASE("Generator concepts", "[generator]") {
+  using iterator = generator<int>::iterator;
+  STATIC_REQUIRE(std::input_iterator<iterator>);
+  STATIC_REQUIRE_FALSE(std::forward_iterator<iterator>);
+  STATIC_REQUIRE(std::sentinel_for<std::default_sentinel_t, iterator>);
+  STATIC_REQUIRE(std::ranges::input_range<generator<int>>);
+  STATIC_REQUIRE(std::ranges::view<generator<int>>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<iterator>, int const&>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<generator<int&>::iterator>, int&>);
+}
+
+TEST_CASE("Generator yields values lazily", "[generator]") {
+  SECTION("finite") {
+    std::vector<int> values;
+    for (int const value : iota(2, 6)) values.push_back(value);
+    REQUIRE(values == std::vector<int>{2, 3, 4, 5});
+    REQUIRE(iota(0, 0).begin() == std::default_sentinel);
+  }
+
+  SECTION("empty") {
+    REQUIRE(generator<int>().begin() == std::default_sentinel);
+    auto gen = iota(0, 3);
+    auto const other = std::move(gen);
+    REQUIRE(gen.begin() == gen.end());  // NOLINT(bugprone-use-after-move)
+  }
+
+  SECTION("infinite with views") {
+    std::vector<long> values;
+    std::ranges::copy(fibonacci() | std::views::take(8), std::back_inserter(values));
+    REQUIRE(values == std::vector<long>{0, 1, 1, 2, 3, 5, 8, 13});
+  }
+
+  SECTION("references") {
+    std::vector<int> values{1, 2, 3};
+    for (int& value : elements(values)) value *= 10;
+    REQUIRE(values == std::vector<int>{10, 20, 30});
+  }
+
+  SECTION("move only values") {
+    std::vector<std::unique_ptr<int>> moved;
+    auto gen = owners(3);
+    for (auto it = gen.begin(); it != gen.end(); ++it) moved.push_back(std::ranges::iter_move(it));
+    REQUIRE(moved.size() == 3);
+    REQUIRE(*moved[2] == 2);
+  }
+
+  SECTION("postfix increment copies the value") {
+    auto gen = iota(0, 3);
+    auto it = gen.begin();
+    REQUIRE(*it++ == 0);
+    REQUIRE(*it == 1);
+  }
+}
+
+TEST_CASE("Generator rethrows exceptions", "[generator]") {
+  auto gen = throwing(2);
+  auto it = gen.begin();
+  REQUIRE(*it == 0);
+  ++it;
+  REQUIRE_THROWS_AS(++it, std::runtime_error);
+  REQUIRE_THROWS_AS(throwing(0).begin(), std::runtime_error);
+}
+
+TEST_CASE("Generator frames use the allocator", "[generator]") {
+  SECTION("allocator argument") {
+    std::size_t allocated = 0;
+    {
+      auto gen = counted_iota(std::allocator_arg, counting_allocator<std::byte>(&allocated), 3);
+      REQUIRE(allocated > 0);
+      REQUIRE(std::ranges::equal(gen, std::vector{0, 1, 2}));
+    }
+    REQUIRE(allocated == 0);
+  }
+
+  SECTION("recycled frames") {
+    auto& pool = frame_pool::local();
+    { REQUIRE(std::ranges::equal(pooled_iota(2), std::vector{0, 1})); }
+    auto const cached = pool.cached();
+    REQUIRE(cached >= 1);
+
+    // every further generator of the same size reuses the cached frame
+    for (int i = 0; i < 100; ++i) {
+      auto gen = pooled_iota(1);
+      REQUIRE(pool.cached() == cached - 1);
+      REQUIRE(*gen.begin() == 0);
+    }
+    REQUIRE(pool.cached() == cached);
+  }
+}
+
+}  // namespace iterator_facade
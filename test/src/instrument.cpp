@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/iterator_facade.hpp>
+
+namespace iterator_facade {
+
+using instrumentation::operation;
+
+struct counted_ints : iterator_facade<counted_ints> {
+  int const* ptr = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return *ptr; }
+  constexpr void advance(std::ptrdiff_t n) noexcept { ptr += n; }
+  [[nodiscard]] constexpr auto distance_to(counted_ints const& other) const noexcept -> std::ptrdiff_t {
+    return other.ptr - ptr;
+  }
+};
+
+struct counted_forward : iterator_facade<counted_forward> {
+  int const* ptr = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return *ptr; }
+  constexpr void increment() noexcept { ++ptr; }
+  [[nodiscard]] constexpr auto equals(counted_forward const& other) const noexcept -> bool { return ptr == other.ptr; }
+};
+
+struct counted_squares : iterator_facade<counted_squares, false, int> {
+  int i = 0;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int { return i * i; }
+  constexpr void increment() noexcept { ++i; }
+  [[nodiscard]] constexpr auto equals(counted_squares const& other) const noexcept -> bool { return i == other.i; }
+};
+
+template <class T>
+auto counts() -> instrumentation::operation_counts {
+  for (auto const& counts : instrumentation::registry::instance().snapshot()) {
+    if (counts.type == instrumentation::type_name<T>()) return counts;
+  }
+  return {};
+}
+
+constexpr static std::array values{1, 2, 3, 4, 5, 6, 7, 8};
+
+TEST_CASE("Instrumentation counts operations per type", "[instrument]") {
+  instrumentation::registry::instance().reset();
+
+  SECTION("random access") {
+    counted_ints const first{{}, values.data()};
+    counted_ints const last{{}, values.data() + values.size()};
+
+    REQUIRE(std::ranges::distance(first, last) == 8);
+    REQUIRE(counts<counted_ints>()[operation::distance_to] == 1);
+
+    auto it = first;
+    std::ranges::advance(it, 5);
+    REQUIRE(*it == 6);
+    auto const after = counts<counted_ints>();
+    REQUIRE(after[operation::advance] == 1);
+    REQUIRE(after[operation::increment] == 0);
+    REQUIRE(after[operation::dereference] == 1);
+  }
+
+  SECTION("forward") {
+    counted_forward const first{{}, values.data()};
+    counted_forward const last{{}, values.data() + values.size()};
+
+    REQUIRE(std::ranges::distance(first, last) == 8);
+    auto const after = counts<counted_forward>();
+    REQUIRE(after[operation::increment] == 8);
+    REQUIRE(after[operation::equals] == 9);
+    REQUIRE(after[operation::dereference] == 0);
+  }
+
+  SECTION("memoized iterators count calls of the hook") {
+    counted_squares it{};
+    REQUIRE(*it + *it + *it.operator->() == 0);
+    ++it;
+    REQUIRE(*it * *it == 1);
+    REQUIRE(counts<counted_squares>()[operation::dereference] == 2);
+  }
+}
+
+TEST_CASE("Instrumentation skips constant evaluation", "[instrument]") {
+  instrumentation::registry::instance().reset();
+
+  constexpr auto distance = [] {
+    counted_ints first{{}, values.data()};
+    counted_ints const last{{}, values.data() + values.size()};
+    ++first;
+    return last - first;
+  }();
+  STATIC_REQUIRE(distance == 7);
+
+  auto const after = counts<counted_ints>();
+  REQUIRE(after[operation::advance] == 0);
+  REQUIRE(after[operation::distance_to] == 0);
+}
+
+TEST_CASE("Instrumentation registry dumps counts", "[instrument]") {
+  instrumentation::registry::instance().reset();
+  counted_forward it{{}, values.data()};
+  ++it;
+  ++it;
+
+  std::ostringstream out;
+  instrumentation::registry::instance().dump(out);
+  auto const dump = out.str();
+  REQUIRE(dump.find("counted_forward: dereference=0 increment=2 decrement=0") != std::string::npos);
+  REQUIRE(instrumentation::name(operation::distance_to) == "distance_to");
+}
+
+}  // namespace iterator_facade
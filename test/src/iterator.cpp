@@ -1,3 +1,12 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include <catch2/catch.hpp>
 #include <iterator_facade/iterator_facade.hpp>
 
@@ -86,6 +95,37 @@ struct contiguous : iterator_facade<contiguous, true> {
   constexpr void advance(difference_type delta) noexcept { ptr += delta; }
 };
 
+// contiguous through to_address() alone, without setting Contiguous
+struct addressed : iterator_facade<addressed> {
+  using difference_type = std::ptrdiff_t;
+
+  int* ptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int& { return *ptr; }
+  [[nodiscard]] constexpr auto to_address() const noexcept -> int* { return ptr; }
+  [[nodiscard]] constexpr auto distance_to(addressed rhs) const noexcept -> difference_type { return rhs.ptr - ptr; }
+  constexpr void advance(difference_type delta) noexcept { ptr += delta; }
+};
+
+// output iterator without increment, like std::back_insert_iterator
+struct appender : iterator_facade<appender> {
+  using difference_type = std::ptrdiff_t;
+
+  std::vector<int>* values;
+
+  void write(int value) { values->push_back(value); }
+};
+
+// output iterator writing to consecutive positions
+struct writer : iterator_facade<writer> {
+  using difference_type = std::ptrdiff_t;
+
+  int* ptr;
+
+  constexpr void write(int value) noexcept { *ptr = value; }
+  constexpr void increment() noexcept { ++ptr; }
+};
+
 TEST_CASE("Iterator concepts", "[concepts]") {
   SECTION("Input iterator") {
     using It = iterator<input_options>;
@@ -162,7 +202,6 @@ TEST_CASE("Iterator concepts", "[concepts]") {
     STATIC_REQUIRE(std::bidirectional_iterator<It>);
     STATIC_REQUIRE(std::random_access_iterator<It>);
 
-    // because of how std::pointer_traits work contiguous_iterator only works for iterator templates... WAT?
     STATIC_REQUIRE(std::contiguous_iterator<It>);
 
     STATIC_REQUIRE(std::sentinel_for<It, It>);
@@ -174,6 +213,58 @@ TEST_CASE("Iterator concepts", "[concepts]") {
     STATIC_REQUIRE(std::to_address(begin) == &array[0]);
     STATIC_REQUIRE(std::to_address(end) == &array[4]);
   }
+
+  SECTION("Contiguous iterator with to_address") {
+    using It = addressed;
+
+    STATIC_REQUIRE(!It::contiguous_iterator);
+    STATIC_REQUIRE(std::same_as<std::iterator_traits<It>::iterator_concept, std::contiguous_iterator_tag>);
+    STATIC_REQUIRE(std::contiguous_iterator<It>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<It>().operator->()), int*>);
+    STATIC_REQUIRE(noexcept(std::to_address(std::declval<It>())));
+
+    std::array<int, 5> array{1, 2, 3, 4, 5};
+    It const begin{{}, array.data()};
+    It const end{{}, array.data() + array.size()};
+
+    REQUIRE(std::to_address(begin) == array.data());
+    // the end is not dereferenced
+    REQUIRE(std::to_address(end) == array.data() + array.size());
+    REQUIRE(std::to_address(begin + 2) == &array[2]);
+    REQUIRE(std::ranges::equal(std::span(begin, end), array));
+  }
+}
+
+TEST_CASE("Output iterators", "[output]") {
+  STATIC_REQUIRE(std::output_iterator<appender, int>);
+  STATIC_REQUIRE(std::output_iterator<appender, short>);
+  STATIC_REQUIRE(!std::input_iterator<appender>);
+  STATIC_REQUIRE(std::same_as<std::iterator_traits<appender>::iterator_category, std::output_iterator_tag>);
+  STATIC_REQUIRE(std::same_as<std::iterator_traits<appender>::value_type, void>);
+  STATIC_REQUIRE(std::same_as<std::iterator_traits<appender>::reference, void>);
+  STATIC_REQUIRE(std::same_as<std::iter_difference_t<appender>, std::ptrdiff_t>);
+  STATIC_REQUIRE(std::output_iterator<writer, int>);
+  STATIC_REQUIRE(noexcept(*std::declval<writer&>() = 1));
+
+  SECTION("appending") {
+    std::vector<int> values;
+    appender it{{}, &values};
+    *it = 1;
+    *it++ = 2;
+    *++it = 3;
+    std::ranges::copy(std::array{4, 5}, it);
+    REQUIRE(values == std::vector<int>{1, 2, 3, 4, 5});
+  }
+
+  SECTION("positional") {
+    std::array<int, 4> values{};
+    writer it{{}, values.data()};
+    *it++ = 1;
+    *it = 2;
+    ++it;
+    std::ranges::fill_n(it, 2, 3);
+    REQUIRE(values == std::array{1, 2, 3, 3});
+  }
 }
 
 TEST_CASE("noexcept are propagated", "[noexcept]") {
@@ -280,6 +371,71 @@ TEST_CASE("iterator is decrementable", "[decrement]") {
 
     STATIC_REQUIRE(it == sentinel{2});
   }
+
+  {
+    constexpr ra_iterator it = []() {
+      auto iter = i;
+      static_cast<void>(iter--);
+      return iter;
+    }();
+
+    STATIC_REQUIRE(it == sentinel{1});
+  }
+}
+
+// single pass iterator owning a buffer, copying it would be expensive so it is move only
+class counting_reader : public iterator_facade<counting_reader> {
+ public:
+  explicit counting_reader(std::size_t buffer_size) : buffer_(buffer_size) {}
+  counting_reader(counting_reader&&) noexcept = default;
+  auto operator=(counting_reader&&) noexcept -> counting_reader& = default;
+
+  [[nodiscard]] auto dereference() const noexcept -> int const& { return buffer_[position_ % buffer_.size()]; }
+  void increment() {
+    ++position_;
+    buffer_[position_ % buffer_.size()] = static_cast<int>(position_);
+  }
+  [[nodiscard]] auto equals(sentinel rhs) const noexcept -> bool {
+    return static_cast<std::int64_t>(position_) == rhs.i;
+  }
+
+ private:
+  std::vector<int> buffer_;
+  std::size_t position_ = 0;
+};
+
+TEST_CASE("Postfix increment of single pass iterators", "[increment]") {
+  SECTION("returns a proxy holding the previous value") {
+    using It = iterator<input_options>;
+    STATIC_REQUIRE(std::input_iterator<It>);
+    STATIC_REQUIRE_FALSE(std::same_as<decltype(std::declval<It&>()++), It>);
+
+    constexpr auto previous = []() {
+      It iter{};
+      iter.value.i = 2;
+      auto const value = *iter++;
+      return std::pair{value.i, (*iter).i};
+    }();
+    STATIC_REQUIRE(previous.first == 2);
+    STATIC_REQUIRE(previous.second == 3);
+    STATIC_REQUIRE(noexcept(std::declval<It&>()++));
+  }
+
+  SECTION("does not copy move only iterators") {
+    STATIC_REQUIRE(std::input_iterator<counting_reader>);
+    STATIC_REQUIRE_FALSE(std::copyable<counting_reader>);
+    STATIC_REQUIRE_FALSE(noexcept(std::declval<counting_reader&>()++));
+
+    counting_reader reader(4);
+    std::vector<int> values;
+    while (reader != sentinel{5}) values.push_back(*reader++);
+    REQUIRE(values == std::vector<int>{0, 1, 2, 3, 4});
+  }
+
+  SECTION("forward iterators return a copy") {
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<iterator<forward_options>&>()++), iterator<forward_options>>);
+    STATIC_REQUIRE(std::same_as<decltype(std::declval<ra_iterator&>()++), ra_iterator>);
+  }
 }
 
 TEST_CASE("iterator is advanceable", "[advance]") {
@@ -303,6 +459,71 @@ TEST_CASE("iterator is advanceable", "[advance]") {
   }
 }
 
+// random access iterator with a separate backward jump which counts its operations and copies
+struct retreating_iterator : iterator_facade<retreating_iterator> {
+  struct counters {
+    int advances = 0;
+    int retreats = 0;
+    int copies = 0;
+  };
+
+  std::ptrdiff_t position = 0;
+  counters* counts = nullptr;
+
+  constexpr retreating_iterator() noexcept = default;
+  constexpr retreating_iterator(std::ptrdiff_t pos, counters* c) noexcept : position(pos), counts(c) {}
+  constexpr retreating_iterator(retreating_iterator const& other) noexcept
+      : position(other.position), counts(other.counts) {
+    if (counts != nullptr) ++counts->copies;
+  }
+  constexpr retreating_iterator(retreating_iterator&&) noexcept = default;
+  constexpr auto operator=(retreating_iterator const&) noexcept -> retreating_iterator& = default;
+  constexpr auto operator=(retreating_iterator&&) noexcept -> retreating_iterator& = default;
+  constexpr ~retreating_iterator() = default;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> std::ptrdiff_t { return position; }
+  constexpr void advance(std::ptrdiff_t n) noexcept {
+    ++counts->advances;
+    position += n;
+  }
+  constexpr void retreat(std::ptrdiff_t n) noexcept {
+    ++counts->retreats;
+    position -= n;
+  }
+  [[nodiscard]] constexpr auto distance_to(retreating_iterator const& other) const noexcept -> std::ptrdiff_t {
+    return other.position - position;
+  }
+};
+
+TEST_CASE("Backward jumps prefer retreat", "[advance]") {
+  STATIC_REQUIRE(std::random_access_iterator<retreating_iterator>);
+  STATIC_REQUIRE(noexcept(std::declval<retreating_iterator&>() -= 1));
+
+  retreating_iterator::counters counts{};
+  retreating_iterator it(10, &counts);
+
+  it -= 3;
+  REQUIRE(*it == 7);
+  --it;
+  REQUIRE(*it == 6);
+  REQUIRE(counts.retreats == 2);
+  REQUIRE(counts.advances == 0);
+  // in place, no temporaries
+  REQUIRE(counts.copies == 0);
+
+  auto const before = it - 4;
+  REQUIRE(*before == 2);
+  REQUIRE(counts.retreats == 3);
+  // only the by-value argument is copied, the result is moved out of it
+  REQUIRE(counts.copies == 1);
+
+  it += 2;
+  REQUIRE(*it == 8);
+  REQUIRE(counts.advances == 1);
+  REQUIRE(before < it);
+  REQUIRE(it > before);
+}
+
 TEST_CASE("iterator is subscriptable", "[subscript]") { STATIC_REQUIRE(i[5].i == 7); }
 
 TEST_CASE("iterators are subtractable", "[subtract]") {
@@ -366,4 +587,242 @@ TEST_CASE("iterators are comparable", "[subtract]") {
   }
 }
 
+// random access view of `values` in the order given by `indices` which counts customization point calls
+template <bool Nothrow = true>
+struct permutation_iterator : iterator_facade<permutation_iterator<Nothrow>> {
+  struct counters {
+    int moves = 0;
+    int swaps = 0;
+  };
+
+  std::vector<int>* values = nullptr;
+  std::size_t const* index = nullptr;
+  counters* calls = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int& { return (*values)[*index]; }
+  constexpr void advance(std::ptrdiff_t delta) noexcept { index += delta; }
+  [[nodiscard]] constexpr auto distance_to(permutation_iterator rhs) const noexcept -> std::ptrdiff_t {
+    return rhs.index - index;
+  }
+
+  [[nodiscard]] constexpr auto iter_move() const noexcept(Nothrow) -> int&& {
+    ++calls->moves;
+    return std::move(dereference());
+  }
+  constexpr void iter_swap(permutation_iterator rhs) const noexcept(Nothrow) {
+    ++calls->swaps;
+    std::swap(dereference(), rhs.dereference());
+  }
+};
+
+TEST_CASE("iter_move and iter_swap are forwarded", "[customization]") {
+  SECTION("noexcept") {
+    permutation_iterator<true> it;
+    permutation_iterator<false> throwing;
+
+    STATIC_REQUIRE(std::same_as<std::iter_rvalue_reference_t<permutation_iterator<true>>, int&&>);
+    STATIC_REQUIRE(noexcept(std::ranges::iter_move(it)));
+    STATIC_REQUIRE(noexcept(std::ranges::iter_swap(it, it)));
+    STATIC_REQUIRE_FALSE(noexcept(std::ranges::iter_move(throwing)));
+    STATIC_REQUIRE_FALSE(noexcept(std::ranges::iter_swap(throwing, throwing)));
+
+    // iterators without the hooks still use the defaults
+    STATIC_REQUIRE(std::same_as<std::iter_rvalue_reference_t<ra_iterator>, wrapper>);
+    STATIC_REQUIRE(noexcept(std::ranges::iter_move(i)));
+  }
+
+  SECTION("algorithms") {
+    std::vector<int> values{50, 40, 30, 20, 10, 0};
+    constexpr std::array<std::size_t, 4> indices{4, 0, 3, 1};
+    permutation_iterator<>::counters calls;
+    permutation_iterator<> const first{{}, &values, indices.data(), &calls};
+    permutation_iterator<> const last{{}, &values, indices.data() + indices.size(), &calls};
+
+    std::ranges::sort(first, last);
+    REQUIRE(values == std::vector<int>{20, 50, 30, 40, 10, 0});
+
+    calls = {};
+    std::ranges::reverse(first, last);
+    REQUIRE(values == std::vector<int>{40, 10, 30, 20, 50, 0});
+    REQUIRE(calls.swaps == 2);
+
+    calls = {};
+    int const value = std::ranges::iter_move(first);
+    REQUIRE(value == 50);
+    REQUIRE(calls.moves == 1);
+
+    std::ranges::iter_swap(first, last - 1);
+    REQUIRE(values == std::vector<int>{40, 50, 30, 20, 10, 0});
+    REQUIRE(calls.swaps == 1);
+  }
+}
+
+// reference to a 4 bit value packed into a byte array
+class nibble_reference {
+ public:
+  using proxy_value_type = std::uint8_t;
+
+  constexpr nibble_reference(std::uint8_t* byte, bool high) noexcept : byte_(byte), high_(high) {}
+  constexpr nibble_reference(nibble_reference const&) noexcept = default;
+  constexpr ~nibble_reference() noexcept = default;
+
+  // assignments write through to the referenced nibble
+  constexpr auto operator=(std::uint8_t value) const noexcept -> nibble_reference const& {
+    auto const shift = high_ ? 4 : 0;
+    *byte_ = static_cast<std::uint8_t>((*byte_ & ~(0xF << shift)) | ((value & 0xF) << shift));
+    return *this;
+  }
+  // NOLINTNEXTLINE(cert-oop54-cpp)
+  constexpr auto operator=(nibble_reference const& other) const noexcept -> nibble_reference const& {
+    return *this = static_cast<std::uint8_t>(other);
+  }
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  [[nodiscard]] constexpr operator std::uint8_t() const noexcept {
+    return static_cast<std::uint8_t>(high_ ? *byte_ >> 4 : *byte_ & 0xF);
+  }
+
+  friend constexpr void swap(nibble_reference lhs, nibble_reference rhs) noexcept {
+    std::uint8_t const tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+
+ private:
+  std::uint8_t* byte_;
+  bool high_;
+};
+
+struct nibble_iterator : iterator_facade<nibble_iterator> {
+  using reference = nibble_reference;
+
+  std::uint8_t* bytes = nullptr;
+  std::ptrdiff_t index = 0;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> nibble_reference {
+    return {bytes + index / 2, index % 2 != 0};
+  }
+  constexpr void advance(std::ptrdiff_t delta) noexcept { index += delta; }
+  [[nodiscard]] constexpr auto distance_to(nibble_iterator rhs) const noexcept -> std::ptrdiff_t {
+    return rhs.index - index;
+  }
+};
+
+TEST_CASE("Proxy references", "[proxy]") {
+  SECTION("concepts") {
+    STATIC_REQUIRE(proxy_reference<nibble_reference>);
+    STATIC_REQUIRE_FALSE(proxy_reference<std::uint8_t&>);
+    STATIC_REQUIRE(std::same_as<std::common_reference_t<nibble_reference&&, std::uint8_t&>, std::uint8_t>);
+    STATIC_REQUIRE(std::same_as<std::common_reference_t<std::uint8_t const&, nibble_reference>, std::uint8_t>);
+
+    STATIC_REQUIRE(std::same_as<std::iterator_traits<nibble_iterator>::reference, nibble_reference>);
+    STATIC_REQUIRE(std::same_as<std::iter_value_t<nibble_iterator>, std::uint8_t>);
+    STATIC_REQUIRE(std::same_as<std::iter_reference_t<nibble_iterator>, nibble_reference>);
+    STATIC_REQUIRE(std::indirectly_readable<nibble_iterator>);
+    STATIC_REQUIRE(std::indirectly_writable<nibble_iterator, std::uint8_t>);
+    STATIC_REQUIRE(std::random_access_iterator<nibble_iterator>);
+    STATIC_REQUIRE(std::sortable<nibble_iterator>);
+  }
+
+  SECTION("algorithms") {
+    std::array<std::uint8_t, 4> bytes{0x3A, 0x1F, 0x72, 0x05};
+    nibble_iterator const first{{}, bytes.data(), 0};
+    nibble_iterator const last = first + 8;
+
+    constexpr std::array<std::uint8_t, 8> nibbles{0xA, 0x3, 0xF, 0x1, 0x2, 0x7, 0x5, 0x0};
+    REQUIRE(std::ranges::equal(std::ranges::subrange(first, last), nibbles));
+    REQUIRE(std::ranges::find(first, last, std::uint8_t{0xF}) == first + 2);
+
+    std::ranges::sort(first, last);
+    REQUIRE(std::ranges::is_sorted(first, last));
+    REQUIRE(bytes == std::array<std::uint8_t, 4>{0x10, 0x32, 0x75, 0xFA});
+
+    std::ranges::reverse(first, last);
+    REQUIRE(bytes == std::array<std::uint8_t, 4>{0xAF, 0x57, 0x23, 0x01});
+
+    std::ranges::fill(first + 2, first + 4, std::uint8_t{0x9});
+    REQUIRE(bytes == std::array<std::uint8_t, 4>{0xAF, 0x99, 0x23, 0x01});
+  }
+}
+
+struct decoded {
+  std::int64_t key = 0;
+  std::int64_t value = 0;
+};
+
+// random access iterator which "decodes" the value at every position and counts the calls
+template <class Cached>
+struct decoding_iterator : iterator_facade<decoding_iterator<Cached>, false, Cached> {
+  std::int64_t position = 0;
+  int* decodes = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> decoded {
+    ++*decodes;
+    return {position, position * position};
+  }
+  constexpr void advance(std::ptrdiff_t delta) noexcept { position += delta; }
+  [[nodiscard]] constexpr auto distance_to(decoding_iterator rhs) const noexcept -> std::ptrdiff_t {
+    return rhs.position - position;
+  }
+};
+
+TEST_CASE("Memoized dereference", "[memoized]") {
+  using memoized_iterator = decoding_iterator<decoded>;
+  using plain_iterator = decoding_iterator<void>;
+
+  SECTION("types") {
+    STATIC_REQUIRE(memoized_iterator::memoized);
+    STATIC_REQUIRE_FALSE(plain_iterator::memoized);
+    STATIC_REQUIRE(sizeof(plain_iterator) == sizeof(std::int64_t) + sizeof(int*));
+    STATIC_REQUIRE(sizeof(contiguous) == sizeof(int const*));
+    STATIC_REQUIRE(std::random_access_iterator<memoized_iterator>);
+    STATIC_REQUIRE(std::same_as<std::iter_reference_t<memoized_iterator>, decoded>);
+    STATIC_REQUIRE(std::same_as<std::iterator_traits<memoized_iterator>::pointer, _ifacade_detail::arrow_proxy<decoded>>);
+    STATIC_REQUIRE(noexcept(*memoized_iterator{}));
+  }
+
+  SECTION("repeated dereferences decode once") {
+    int decodes = 0;
+    memoized_iterator it{{}, 3, &decodes};
+
+    REQUIRE((*it).value == 9);
+    REQUIRE(it->key == 3);
+    REQUIRE(it->value == 9);
+    REQUIRE(decodes == 1);
+
+    ++it;
+    REQUIRE(it->value == 16);
+    it += 2;
+    REQUIRE(it->value == 36);
+    --it;
+    REQUIRE(it->value == 25);
+    it -= 4;
+    REQUIRE(it->value == 1);
+    REQUIRE((*it).key == 1);
+    REQUIRE(decodes == 5);
+
+    // copies keep the cached value
+    auto const copy = it;
+    REQUIRE(copy->value == 1);
+    REQUIRE(decodes == 5);
+
+    int plain_decodes = 0;
+    plain_iterator const plain{{}, 3, &plain_decodes};
+    REQUIRE((*plain).value == 9);
+    REQUIRE(plain->key == 3);
+    REQUIRE(plain_decodes == 2);
+  }
+
+  SECTION("arrow on temporary iterators") {
+    int decodes = 0;
+    memoized_iterator const it{{}, 3, &decodes};
+
+    // the reverse iterator dereferences a temporary copy of its base
+    std::reverse_iterator<memoized_iterator> const reversed{it};
+    REQUIRE(reversed->key == 2);
+    REQUIRE(reversed->value == 4);
+    REQUIRE(std::next(it).operator->()->value == 16);
+  }
+}
+
 }  // namespace iterator_facade
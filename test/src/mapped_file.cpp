@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/mapped_file.hpp>
+
+#if __has_include(<sys/mman.h>)
+
+namespace iterator_facade {
+
+struct log_record {
+  std::uint32_t timestamp;
+  std::int32_t value;
+};
+
+// file in the temporary directory which is removed at the end of the test
+class temporary_file {
+ public:
+  explicit temporary_file(std::string_view name, void const* data, std::size_t size)
+      : path_(std::filesystem::temp_directory_path() / name) {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+  }
+  temporary_file(temporary_file const&) = delete;
+  auto operator=(temporary_file const&) -> temporary_file& = delete;
+  ~temporary_file() { std::filesystem::remove(path_); }
+
+  [[nodiscard]] auto path() const -> std::filesystem::path const& { return path_; }
+
+ private:
+  std::filesystem::path path_;
+};
+
+TEST_CASE("Mapped record iterator concepts", "[mapped]") {
+  STATIC_REQUIRE(std::contiguous_iterator<record_iterator<log_record>>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<record_iterator<log_record>>, log_record const&>);
+  STATIC_REQUIRE(std::random_access_iterator<indexed_record_iterator>);
+  STATIC_REQUIRE(std::same_as<std::iter_value_t<indexed_record_iterator>, std::span<std::byte const>>);
+}
+
+TEST_CASE("Mapped fixed size records", "[mapped]") {
+  std::vector<log_record> const written{{10, 3}, {20, -1}, {30, 7}, {40, 2}};
+  temporary_file const file("iterf_fixed_records.bin", written.data(), written.size() * sizeof(log_record));
+  mapped_file const mapped(file.path());
+  REQUIRE(mapped.size() == written.size() * sizeof(log_record));
+
+  SECTION("iterator range") {
+    auto const records = mapped.records<log_record>();
+    REQUIRE(std::ranges::size(records) == 4);
+    REQUIRE(std::ranges::equal(records, written, {}, &log_record::value, &log_record::value));
+
+    auto const found = std::ranges::lower_bound(records, 25U, {}, &log_record::timestamp);
+    REQUIRE(found->value == 7);
+    // contiguous, so the records are not copied
+    REQUIRE(std::to_address(records.begin()) == static_cast<void const*>(mapped.data()));
+  }
+
+  SECTION("span") {
+    auto const span = mapped.as_span<log_record>(sizeof(log_record), 2);
+    REQUIRE(span.size() == 2);
+    REQUIRE(span[0].timestamp == 20);
+    REQUIRE(span[1].timestamp == 30);
+    REQUIRE(mapped.as_span<log_record>(3 * sizeof(log_record)).size() == 1);
+  }
+
+  SECTION("errors") {
+    REQUIRE_THROWS_AS(mapped.as_span<log_record>(2), std::invalid_argument);
+    REQUIRE_THROWS_AS(mapped.as_span<log_record>(0, 5), std::out_of_range);
+    REQUIRE_THROWS_AS(mapped_file(file.path() / "missing"), std::system_error);
+  }
+
+  SECTION("move") {
+    mapped_file original(file.path());
+    mapped_file const moved = std::move(original);
+    REQUIRE(moved.size() == written.size() * sizeof(log_record));
+    REQUIRE(original.data() == nullptr);  // NOLINT(bugprone-use-after-move)
+    REQUIRE(moved.records<log_record>().begin()->timestamp == 10);
+  }
+}
+
+TEST_CASE("Mapped variable length records", "[mapped]") {
+  // records prefixed by their one byte length
+  constexpr std::array<unsigned char, 12> written{3, 'a', 'b', 'c', 1, 'd', 0, 4, 'e', 'f', 'g', 'h'};
+  temporary_file const file("iterf_variable_records.bin", written.data(), written.size());
+  mapped_file const mapped(file.path());
+
+  auto const index = build_offset_index(mapped.bytes(), [](std::span<std::byte const> rest) {
+    return static_cast<std::size_t>(rest.front()) + 1;
+  });
+  REQUIRE(index == std::vector<std::uint64_t>{0, 4, 6, 7, 12});
+
+  auto const records = mapped.records(index);
+  REQUIRE(std::ranges::size(records) == 4);
+  auto const payload = [](std::span<std::byte const> record) {
+    return std::string_view(reinterpret_cast<char const*>(record.data()) + 1, record.size() - 1);  // NOLINT
+  };
+  REQUIRE(payload(records[0]) == "abc");
+  REQUIRE(payload(records[1]) == "d");
+  REQUIRE(payload(records[2]).empty());
+  REQUIRE(payload(*(records.end() - 1)) == "efgh");
+  REQUIRE((records.begin() + 3).offset() == 7);
+
+  // a corrupt index must not address bytes outside of the mapping
+  std::array<std::uint64_t, 3> const unsorted{0, std::uint64_t{1} << 40U, 10};
+  REQUIRE_THROWS_AS(mapped.records(unsorted), std::out_of_range);
+  std::array<std::uint64_t, 3> const decreasing{0, 6, 4};
+  REQUIRE_THROWS_AS(mapped.records(decreasing), std::out_of_range);
+
+  REQUIRE_THROWS_AS(build_offset_index(mapped.bytes(), [](auto const&) { return std::size_t{5}; }),
+                    std::out_of_range);
+}
+
+TEST_CASE("Mapped empty file", "[mapped]") {
+  temporary_file const file("iterf_empty.bin", nullptr, 0);
+  mapped_file const mapped(file.path());
+  REQUIRE(mapped.size() == 0);
+  REQUIRE(std::ranges::empty(mapped.records<log_record>()));
+  REQUIRE_NOTHROW(mapped.advise(access_pattern::willneed));
+}
+
+}  // namespace iterator_facade
+
+#endif
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/parallel.hpp>
+
+namespace iterator_facade {
+
+// random access iterator over the integers, like an index over a table
+struct index_iterator : iterator_facade<index_iterator> {
+  std::int64_t index = 0;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> std::int64_t { return index; }
+  constexpr void advance(std::ptrdiff_t delta) noexcept { index += delta; }
+  [[nodiscard]] constexpr auto distance_to(index_iterator rhs) const noexcept -> std::ptrdiff_t {
+    return rhs.index - index;
+  }
+};
+
+TEST_CASE("Thread pool", "[parallel]") {
+  SECTION("runs every task once") {
+    for (std::size_t workers : {0U, 1U, 3U}) {
+      thread_pool pool(workers);
+      REQUIRE(pool.concurrency() == workers + 1);
+
+      std::vector<std::atomic<int>> counts(1000);
+      pool.run(counts.size(), [&](std::size_t i) { ++counts[i]; });
+      REQUIRE(std::ranges::all_of(counts, [](auto const& count) { return count == 1; }));
+    }
+  }
+
+  SECTION("nested runs do not deadlock") {
+    thread_pool pool(2);
+    std::atomic<int> total = 0;
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { ++total; }); });
+    REQUIRE(total == 64);
+  }
+
+  SECTION("rethrows after all tasks finished") {
+    thread_pool pool(3);
+    std::atomic<int> finished = 0;
+    REQUIRE_THROWS_AS(pool.run(100,
+                               [&](std::size_t i) {
+                                 if (i % 10 == 3) throw std::runtime_error("task failed");
+                                 ++finished;
+                               }),
+                      std::runtime_error);
+    REQUIRE(finished == 90);
+  }
+}
+
+TEST_CASE("Parallel algorithms", "[parallel][algorithms]") {
+  constexpr std::int64_t size = 100'000;
+  index_iterator const first{{}, 0};
+  index_iterator const last{{}, size};
+  thread_pool pool(3);
+
+  SECTION("for_each") {
+    std::vector<std::atomic<std::int64_t>> visited(size);
+    parallel_for_each(pool, first, last, [&](std::int64_t i) { visited[static_cast<std::size_t>(i)] += i + 1; });
+    for (std::int64_t i = 0; i < size; ++i) REQUIRE(visited[static_cast<std::size_t>(i)] == i + 1);
+
+    std::atomic<std::int64_t> sum = 0;
+    parallel_for_each(first, last, [&](std::int64_t i) { sum += i; });
+    REQUIRE(sum == size * (size - 1) / 2);
+  }
+
+  SECTION("transform_reduce") {
+    auto const squares = parallel_transform_reduce(pool, first, last, std::int64_t{0}, std::plus<>{},
+                                                   [](std::int64_t i) { return i * i; });
+    REQUIRE(squares == (size - 1) * size * (2 * size - 1) / 6);
+    REQUIRE(parallel_transform_reduce(first, last, std::int64_t{1}) == 1 + size * (size - 1) / 2);
+    REQUIRE(parallel_transform_reduce(pool, first, first, std::int64_t{42}, std::plus<>{}, std::identity{}) == 42);
+
+    // partial results are combined in order
+    auto const digits = parallel_transform_reduce(
+        pool, first, first + 20, std::string(">"), std::plus<>{},
+        [](std::int64_t i) { return std::string(1, static_cast<char>('a' + i)); });
+    REQUIRE(digits == ">abcdefghijklmnopqrst");
+  }
+
+  SECTION("copy") {
+    std::vector<std::int64_t> copied(size);
+    REQUIRE(parallel_copy(pool, first, last, copied.begin()) == copied.end());
+    for (std::int64_t i = 0; i < size; ++i) REQUIRE(copied[static_cast<std::size_t>(i)] == i);
+
+    std::vector<std::int64_t> few(3);
+    REQUIRE(parallel_copy(first + 5, first + 8, few.begin()) == few.end());
+    REQUIRE(few == std::vector<std::int64_t>{5, 6, 7});
+  }
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <forward_list>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/prefetching_iterator.hpp>
+
+namespace iterator_facade {
+
+// forward iterator over an array which records the furthest element it dereferenced
+struct checked_iterator : iterator_facade<checked_iterator> {
+  int const* ptr = nullptr;
+  int const* first = nullptr;
+  std::ptrdiff_t* furthest = nullptr;
+
+  [[nodiscard]] auto dereference() const noexcept -> int const& {
+    *furthest = std::max(*furthest, ptr - first);
+    return *ptr;
+  }
+  void increment() noexcept { ++ptr; }
+  [[nodiscard]] auto equals(checked_iterator const& other) const noexcept -> bool { return ptr == other.ptr; }
+};
+
+// random access iterator over base[index[i]]
+struct indirect_iterator : iterator_facade<indirect_iterator> {
+  int const* base = nullptr;
+  std::size_t const* index = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return base[*index]; }
+  constexpr void advance(std::ptrdiff_t n) noexcept { index += n; }
+  [[nodiscard]] constexpr auto distance_to(indirect_iterator const& other) const noexcept -> std::ptrdiff_t {
+    return other.index - index;
+  }
+};
+
+TEST_CASE("Prefetching iterator concepts", "[prefetch]") {
+  using pointer_iterator = prefetching_iterator<int*, 8>;
+  STATIC_REQUIRE(std::random_access_iterator<pointer_iterator>);
+  STATIC_REQUIRE(std::sortable<pointer_iterator>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<pointer_iterator>, int&>);
+  // random access iterators need no lookahead copy
+  STATIC_REQUIRE(sizeof(pointer_iterator) == 2 * sizeof(int*));
+  STATIC_REQUIRE(nothrow_increment<pointer_iterator>);
+
+  using list_iterator = prefetching_iterator<std::forward_list<int>::iterator>;
+  STATIC_REQUIRE(std::forward_iterator<list_iterator>);
+  STATIC_REQUIRE_FALSE(std::bidirectional_iterator<list_iterator>);
+  STATIC_REQUIRE(std::random_access_iterator<prefetching_iterator<indirect_iterator, 4>>);
+}
+
+TEST_CASE("Prefetching iterator traverses ranges", "[prefetch]") {
+  SECTION("random access") {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    auto const range = prefetched<8>(values);
+    REQUIRE(std::accumulate(range.begin(), range.end(), 0) == 4950);
+    REQUIRE(std::ranges::size(range) == 100);
+    REQUIRE(range.begin()[42] == 42);
+
+    std::ranges::sort(range, std::greater{});
+    REQUIRE(values.front() == 99);
+  }
+
+  SECTION("constant evaluation") {
+    constexpr static std::array values{1, 2, 3, 4};
+    STATIC_REQUIRE(std::ranges::equal(prefetched<2>(values), values));
+  }
+
+  SECTION("indirect") {
+    std::array const values{10, 20, 30, 40, 50};
+    std::array<std::size_t, 5> const permutation{4, 2, 0, 3, 1};
+    indirect_iterator const first{{}, values.data(), permutation.data()};
+    indirect_iterator const last{{}, values.data(), permutation.data() + permutation.size()};
+
+    prefetching_iterator<indirect_iterator, 2> const prefetching(first, last);
+    REQUIRE(std::ranges::equal(std::ranges::subrange(prefetching, decltype(prefetching)(last, last)),
+                               std::array{50, 30, 10, 40, 20}));
+  }
+
+  SECTION("forward list") {
+    std::forward_list<int> const list{1, 2, 3, 4, 5, 6};
+    REQUIRE(std::ranges::equal(prefetched<4>(list), list));
+    REQUIRE(std::ranges::equal(prefetched<100>(list), list));
+  }
+}
+
+// walk a range of 10 elements and return the furthest element that was prefetched
+template <std::ptrdiff_t Distance>
+auto furthest_prefetched() -> std::ptrdiff_t {
+  std::array<int, 10> const values{};
+  std::ptrdiff_t furthest = -1;
+  checked_iterator const first{{}, values.data(), values.data(), &furthest};
+  checked_iterator const last{{}, values.data() + values.size(), values.data(), &furthest};
+
+  std::ptrdiff_t count = 0;
+  for (prefetching_iterator<checked_iterator, Distance> it(first, last), end(last, last); it != end; ++it) ++count;
+  REQUIRE(count == 10);
+  return furthest;
+}
+
+TEST_CASE("Prefetching iterator stays before the end", "[prefetch]") {
+  // incrementing to i prefetches i + Distance, the last element is prefetched unless it is reached by then
+  REQUIRE(furthest_prefetched<1>() == 9);
+  REQUIRE(furthest_prefetched<3>() == 9);
+  REQUIRE(furthest_prefetched<8>() == 9);
+  REQUIRE(furthest_prefetched<9>() == -1);
+  REQUIRE(furthest_prefetched<20>() == -1);
+}
+
+}  // namespace iterator_facade
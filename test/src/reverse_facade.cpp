@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/reverse_facade.hpp>
+
+namespace iterator_facade {
+
+// bidirectional iterator over an array which counts its decrements
+struct counted_iterator : iterator_facade<counted_iterator> {
+  int const* ptr = nullptr;
+  int* decrements = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return *ptr; }
+  constexpr void increment() noexcept { ++ptr; }
+  constexpr void decrement() noexcept {
+    ++*decrements;
+    --ptr;
+  }
+  [[nodiscard]] constexpr auto equals(counted_iterator const& other) const noexcept -> bool {
+    return ptr == other.ptr;
+  }
+};
+
+TEST_CASE("reverse_facade concepts", "[reverse]") {
+  STATIC_REQUIRE(std::random_access_iterator<reverse_facade<int*>>);
+  STATIC_REQUIRE_FALSE(std::contiguous_iterator<reverse_facade<int*>>);
+  STATIC_REQUIRE(std::sortable<reverse_facade<int*>>);
+  STATIC_REQUIRE(std::bidirectional_iterator<reverse_facade<std::list<int>::iterator>>);
+  STATIC_REQUIRE_FALSE(std::random_access_iterator<reverse_facade<std::list<int>::iterator>>);
+  STATIC_REQUIRE(std::bidirectional_iterator<reverse_facade<counted_iterator>>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<reverse_facade<int*>>, int&>);
+
+  STATIC_REQUIRE(nothrow_dereference<reverse_facade<int*>>);
+  STATIC_REQUIRE(nothrow_increment<reverse_facade<int*>>);
+  STATIC_REQUIRE(nothrow_advance<reverse_facade<int*>>);
+  STATIC_REQUIRE(noexcept(std::ranges::iter_move(std::declval<reverse_facade<int*> const&>())));
+  STATIC_REQUIRE(noexcept(std::ranges::iter_swap(std::declval<reverse_facade<int*> const&>(),
+                                                 std::declval<reverse_facade<int*> const&>())));
+}
+
+TEST_CASE("reverse_facade reverses ranges", "[reverse]") {
+  constexpr static std::array values{1, 2, 3, 4, 5};
+
+  SECTION("random access") {
+    auto const range = reversed(values);
+    REQUIRE(std::ranges::equal(range, std::array{5, 4, 3, 2, 1}));
+    REQUIRE(std::ranges::size(range) == 5);
+    REQUIRE(range.begin()[1] == 4);
+    REQUIRE(*(range.end() - 1) == 1);
+    REQUIRE(range.begin() < range.end());
+    REQUIRE(range.end().base() == values.begin());
+  }
+
+  SECTION("bidirectional") {
+    std::list<int> list{1, 2, 3};
+    auto const range = reversed(list);
+    REQUIRE(std::ranges::equal(range, std::array{3, 2, 1}));
+
+    auto it = std::ranges::next(range.begin(), 2);
+    REQUIRE(*it == 1);
+    REQUIRE(*--it == 2);
+    REQUIRE(*--it == 3);
+    REQUIRE(it == range.begin());
+  }
+
+  SECTION("algorithms write through") {
+    std::vector<int> vector{3, 1, 4, 1, 5};
+    std::ranges::sort(reversed(vector));
+    REQUIRE(vector == std::vector<int>{5, 4, 3, 1, 1});
+    std::ranges::reverse(reversed(vector));
+    REQUIRE(vector == std::vector<int>{1, 1, 3, 4, 5});
+  }
+}
+
+TEST_CASE("reverse_facade decrements once per element", "[reverse]") {
+  constexpr static std::array values{1, 2, 3, 4, 5, 6, 7, 8};
+  int decrements = 0;
+  counted_iterator const first{{}, values.data(), &decrements};
+  counted_iterator const last{{}, values.data() + values.size(), &decrements};
+
+  SECTION("reverse_facade") {
+    int sum = 0;
+    for (reverse_facade it(last); it != reverse_facade(first); ++it) sum += *it;
+    REQUIRE(sum == 36);
+    REQUIRE(decrements == 8);
+
+    // dereferencing again reuses the decremented position
+    reverse_facade it(last);
+    REQUIRE(*it == 8);
+    REQUIRE(*it == 8);
+    REQUIRE(decrements == 9);
+  }
+
+  SECTION("std::reverse_iterator") {
+    int sum = 0;
+    for (std::reverse_iterator it(last); it != std::reverse_iterator(first); ++it) sum += *it;
+    REQUIRE(sum == 36);
+    REQUIRE(decrements == 16);
+  }
+}
+
+}  // namespace iterator_facade
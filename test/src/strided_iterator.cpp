@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/strided_iterator.hpp>
+
+namespace iterator_facade {
+
+TEST_CASE("Strided iterator concepts", "[strided]") {
+  using static_iterator = strided_iterator<int*, 3>;
+  using dynamic_iterator = strided_iterator<int*>;
+
+  STATIC_REQUIRE(std::random_access_iterator<static_iterator>);
+  STATIC_REQUIRE(std::random_access_iterator<dynamic_iterator>);
+  STATIC_REQUIRE_FALSE(std::contiguous_iterator<static_iterator>);
+  STATIC_REQUIRE(std::sortable<static_iterator>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<static_iterator>, int&>);
+  STATIC_REQUIRE(static_iterator::static_stride);
+  STATIC_REQUIRE_FALSE(dynamic_iterator::static_stride);
+
+  // a compile time stride takes no space
+  STATIC_REQUIRE(sizeof(static_iterator) == sizeof(int*) + sizeof(std::ptrdiff_t));
+  STATIC_REQUIRE(sizeof(dynamic_iterator) == sizeof(int*) + 2 * sizeof(std::ptrdiff_t));
+
+  STATIC_REQUIRE(nothrow_dereference<static_iterator>);
+  STATIC_REQUIRE(nothrow_advance<static_iterator>);
+  STATIC_REQUIRE(nothrow_distance_to<static_iterator>);
+}
+
+TEST_CASE("Strided iterator walks columns", "[strided]") {
+  // 4 x 3 row-major matrix
+  constexpr static std::array<int, 12> matrix{0, 1, 2, 10, 11, 12, 20, 21, 22, 30, 31, 32};
+  constexpr std::ptrdiff_t rows = 4;
+  constexpr std::ptrdiff_t cols = 3;
+
+  SECTION("compile time stride") {
+    constexpr auto column = strided<cols>(matrix.data() + 1, rows);
+    STATIC_REQUIRE(std::ranges::size(column) == 4);
+    STATIC_REQUIRE(std::ranges::equal(column, std::array{1, 11, 21, 31}));
+    STATIC_REQUIRE(column.begin()[2] == 21);
+    STATIC_REQUIRE(*(column.end() - 1) == 31);
+    STATIC_REQUIRE(column.end() - column.begin() == rows);
+    STATIC_REQUIRE(std::accumulate(column.begin(), column.end(), 0) == 64);
+  }
+
+  SECTION("runtime stride") {
+    auto const column = strided(matrix.data() + 2, rows, cols);
+    REQUIRE(std::ranges::equal(column, std::array{2, 12, 22, 32}));
+    REQUIRE(column.begin().stride() == cols);
+
+    // every row starting at the second is a stride over the flattened matrix as well
+    auto const row = strided(matrix.data() + cols, cols, 1);
+    REQUIRE(std::ranges::equal(row, std::array{10, 11, 12}));
+
+    auto const reversed = strided(matrix.data() + 11, rows, -cols);
+    REQUIRE(std::ranges::equal(reversed, std::array{32, 22, 12, 2}));
+  }
+
+  SECTION("algorithms write through") {
+    std::vector<int> interleaved{5, 0, 3, 1, 4, 2, 1, 3, 2, 4};
+    auto const left = strided<2>(interleaved.data(), 5);
+    std::ranges::sort(left);
+    REQUIRE(interleaved == std::vector<int>{1, 0, 2, 1, 3, 2, 4, 3, 5, 4});
+
+    auto const right = strided(interleaved.data() + 1, 5, 2);
+    std::ranges::reverse(right);
+    REQUIRE(interleaved == std::vector<int>{1, 4, 2, 3, 3, 2, 4, 1, 5, 0});
+    REQUIRE(std::ranges::lower_bound(left, 3) == left.begin() + 2);
+  }
+}
+
+TEST_CASE("Strided iterator gathers batches", "[strided]") {
+  constexpr static std::array<int, 16> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  constexpr strided_iterator<int const*, 4> it(values.data() + 1);
+  STATIC_REQUIRE(it.gather<4>() == std::array{1, 5, 9, 13});
+  STATIC_REQUIRE((it + 1).gather<3>() == std::array{5, 9, 13});
+
+  strided_iterator<int const*> const dynamic(values.data(), 1, 5);
+  REQUIRE(dynamic.gather<3>() == std::array{5, 10, 15});
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/reverse_facade.hpp>
+#include <iterator_facade/utf8_iterator.hpp>
+
+namespace iterator_facade {
+
+TEST_CASE("UTF-8 iterator concepts", "[utf8]") {
+  using iterator = utf8_iterator<char>;
+
+  STATIC_REQUIRE(std::bidirectional_iterator<iterator>);
+  STATIC_REQUIRE_FALSE(std::random_access_iterator<iterator>);
+  STATIC_REQUIRE(std::sized_sentinel_for<iterator, iterator>);
+  STATIC_REQUIRE(std::same_as<std::iter_value_t<iterator>, char32_t>);
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<iterator>, char32_t>);
+  STATIC_REQUIRE(std::bidirectional_iterator<utf8_iterator<char8_t>>);
+  STATIC_REQUIRE(std::ranges::sized_range<decltype(utf8(std::string_view{}))>);
+  STATIC_REQUIRE(nothrow_dereference<iterator>);
+  STATIC_REQUIRE(nothrow_increment<iterator>);
+}
+
+TEST_CASE("UTF-8 iterator decodes code points", "[utf8]") {
+  std::u8string_view const text = u8"aé€\U0001F600z";
+  std::array<char32_t, 5> const expected{U'a', U'é', U'€', U'\U0001F600', U'z'};
+  auto const range = utf8(text);
+
+  REQUIRE(std::ranges::equal(range, expected));
+  REQUIRE(std::ranges::equal(reversed(range), std::views::reverse(expected)));
+  REQUIRE(std::ranges::size(range) == 5);
+  REQUIRE(std::ranges::distance(range.begin(), range.end()) == 5);
+  REQUIRE(range.end() - range.begin() == 5);
+  REQUIRE(range.begin() - range.end() == -5);
+
+  auto it = std::ranges::next(range.begin(), 3);
+  REQUIRE(it.base() == text.data() + 6);
+  REQUIRE(*it == U'\U0001F600');
+  REQUIRE(*--it == U'€');
+  REQUIRE(it - range.begin() == 2);
+}
+
+TEST_CASE("UTF-8 iterator replaces malformed code points", "[utf8]") {
+  constexpr char32_t r = U'\uFFFD';
+  auto const decoded = [](std::string_view text) {
+    auto const range = utf8(text);
+    REQUIRE(std::ranges::distance(range) == std::ranges::distance(range.begin(), range.end()));
+    std::vector<char32_t> forward(range.begin(), range.end());
+    std::vector<char32_t> backward(reversed(range).begin(), reversed(range).end());
+    std::ranges::reverse(backward);
+    REQUIRE(forward == backward);
+    REQUIRE(static_cast<std::ptrdiff_t>(forward.size()) == range.end() - range.begin());
+    return forward;
+  };
+
+  // stray continuation bytes at the start and after a complete sequence
+  REQUIRE(decoded("\x80\x80"
+                  "a") == std::vector<char32_t>{r, U'a'});
+  REQUIRE(decoded("a\x80"
+                  "b") == std::vector<char32_t>{r, U'b'});
+  // truncated sequences
+  REQUIRE(decoded("\xE2\x82") == std::vector<char32_t>{r});
+  REQUIRE(decoded("\xE2\x82"
+                  "a") == std::vector<char32_t>{r, U'a'});
+  REQUIRE(decoded("\xF0\x9F\x98") == std::vector<char32_t>{r});
+  // overlong encodings, surrogates, values beyond U+10FFFF and invalid lead bytes
+  REQUIRE(decoded("\xC0\xAF") == std::vector<char32_t>{r});
+  REQUIRE(decoded("\xE0\x80\xAF") == std::vector<char32_t>{r});
+  REQUIRE(decoded("\xED\xA0\x80") == std::vector<char32_t>{r});
+  REQUIRE(decoded("\xF4\x90\x80\x80") == std::vector<char32_t>{r});
+  REQUIRE(decoded("\xFF"
+                  "a") == std::vector<char32_t>{r, U'a'});
+  REQUIRE(decoded("\xF4\x8F\xBF\xBF") == std::vector<char32_t>{U'\U0010FFFF'});
+}
+
+// compares the chunked advance and distance with code point by code point iteration in texts longer than the chunks
+TEST_CASE("UTF-8 iterator advances and measures in chunks", "[utf8]") {
+  std::string text;
+  for (int i = 0; i < 20; ++i) text += i % 3 == 0 ? "ascii text " : "\xCE\xB1\xE2\x82\xAC\xF0\x9F\x98\x80 ";
+  text += "\x80\x80";
+
+  auto const range = utf8(text);
+  std::vector<utf8_iterator<char>> positions;
+  for (auto it = range.begin(); it != range.end(); ++it) positions.push_back(it);
+  positions.push_back(range.end());
+  auto const count = static_cast<std::ptrdiff_t>(positions.size());
+
+  REQUIRE(std::ranges::size(range) == positions.size() - 1);
+  for (std::ptrdiff_t from = 0; from < count; from += 3) {
+    for (std::ptrdiff_t to = 0; to < count; ++to) {
+      INFO("from " << from << " to " << to);
+      auto const first = positions[static_cast<std::size_t>(from)];
+      auto const last = positions[static_cast<std::size_t>(to)];
+      REQUIRE(last - first == to - from);
+
+      auto it = first;
+      advance(it, to - from);
+      REQUIRE(it == last);
+    }
+  }
+
+  // advancing past the bounds stops at them
+  auto it = range.begin();
+  advance(it, count + 10);
+  REQUIRE(it == range.end());
+  advance(it, -count - 10);
+  REQUIRE(it == range.begin());
+}
+
+// the SWAR fallback is only used without SSE2, so it is checked directly against the byte by byte count
+TEST_CASE("UTF-8 SWAR chunks count leads like the scalar loop", "[utf8]") {
+  auto const scalar = [](std::array<char, 8> const& bytes) {
+    return std::ranges::count_if(bytes, [](char c) { return !_ifacade_detail::is_continuation(c); });
+  };
+
+  // every byte value at every position, surrounded by continuation and ASCII bytes
+  for (char const fill : {'\x80', 'a', '\xBF', '\xC0'}) {
+    for (std::size_t position = 0; position < 8; ++position) {
+      for (int value = 0; value < 256; ++value) {
+        std::array<char, 8> bytes{};
+        bytes.fill(fill);
+        bytes[position] = static_cast<char>(value);
+        INFO("fill " << static_cast<int>(fill) << " position " << position << " value " << value);
+        REQUIRE(_ifacade_detail::swar_utf8_leads(bytes.data()) == scalar(bytes));
+      }
+    }
+  }
+
+  // pseudo-random words
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (int i = 0; i < 10000; ++i) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    std::array<char, 8> bytes{};
+    std::memcpy(bytes.data(), &state, sizeof(state));
+    REQUIRE(_ifacade_detail::swar_utf8_leads(bytes.data()) == scalar(bytes));
+  }
+}
+
+TEST_CASE("UTF-8 iterator in constant expressions", "[utf8]") {
+  constexpr auto code_points = [] {
+    std::u8string_view const text = u8"été \U0001F600";
+    auto const range = utf8(text);
+    auto it = range.begin();
+    advance(it, 4);
+    return std::pair{range.end() - range.begin(), *it};
+  }();
+  STATIC_REQUIRE(code_points.first == 5);
+  STATIC_REQUIRE(code_points.second == U'\U0001F600');
+}
+
+}  // namespace iterator_facade
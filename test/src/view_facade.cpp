@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/view_facade.hpp>
+
+namespace iterator_facade {
+
+struct int_iterator : iterator_facade<int_iterator, true> {
+  using difference_type = std::ptrdiff_t;
+
+  int const* ptr = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> int const& { return *ptr; }
+  constexpr void advance(difference_type n) noexcept { ptr += n; }
+  [[nodiscard]] constexpr auto distance_to(int_iterator rhs) const noexcept -> difference_type {
+    return rhs.ptr - ptr;
+  }
+};
+
+class int_span : public view_facade<int_span> {
+ public:
+  constexpr int_span() noexcept = default;
+  constexpr int_span(int const* first, int const* last) noexcept : first_(first), last_(last) {}
+
+  [[nodiscard]] constexpr auto make_begin() const noexcept -> int_iterator { return {{}, first_}; }
+  [[nodiscard]] constexpr auto make_end() const noexcept -> int_iterator { return {{}, last_}; }
+
+ private:
+  int const* first_ = nullptr;
+  int const* last_ = nullptr;
+};
+
+// forward iterator with a sentinel that is not sized: a null terminated sequence
+struct zstring_iterator : iterator_facade<zstring_iterator> {
+  char const* ptr = nullptr;
+
+  [[nodiscard]] constexpr auto dereference() const noexcept -> char const& { return *ptr; }
+  constexpr void increment() noexcept { ++ptr; }
+  [[nodiscard]] constexpr auto equals(zstring_iterator rhs) const noexcept -> bool { return ptr == rhs.ptr; }
+  [[nodiscard]] constexpr auto equals(std::default_sentinel_t /*unused*/) const noexcept -> bool {
+    return *ptr == '\0';
+  }
+};
+
+class zstring : public view_facade<zstring> {
+ public:
+  constexpr zstring() noexcept = default;
+  constexpr explicit zstring(char const* str) noexcept : str_(str) {}
+
+  [[nodiscard]] constexpr auto make_begin() const noexcept -> zstring_iterator { return {{}, str_}; }
+  [[nodiscard]] constexpr static auto make_end() noexcept -> std::default_sentinel_t { return {}; }
+
+ private:
+  char const* str_ = "";
+};
+
+// view over the non-zero suffix of a range, finding the first element is O(n) so the begin iterator is cached
+class skip_zeros : public view_facade<skip_zeros, int_iterator> {
+ public:
+  skip_zeros() noexcept = default;
+  skip_zeros(int const* first, int const* last, int* calls) noexcept : first_(first), last_(last), calls_(calls) {}
+
+  [[nodiscard]] auto make_begin() const noexcept -> int_iterator {
+    ++*calls_;
+    return {{}, std::find_if(first_, last_, [](int value) { return value != 0; })};
+  }
+  [[nodiscard]] auto make_end() const noexcept -> int_iterator { return {{}, last_}; }
+
+ private:
+  int const* first_ = nullptr;
+  int const* last_ = nullptr;
+  int* calls_ = nullptr;
+};
+
+TEST_CASE("view_facade infers range concepts", "[view]") {
+  SECTION("contiguous") {
+    STATIC_REQUIRE(std::ranges::view<int_span>);
+    STATIC_REQUIRE(std::ranges::contiguous_range<int_span>);
+    STATIC_REQUIRE(std::ranges::contiguous_range<int_span const>);
+    STATIC_REQUIRE(std::ranges::sized_range<int_span>);
+    STATIC_REQUIRE(std::ranges::common_range<int_span>);
+  }
+
+  SECTION("forward with sentinel") {
+    STATIC_REQUIRE(std::ranges::view<zstring>);
+    STATIC_REQUIRE(std::ranges::forward_range<zstring>);
+    STATIC_REQUIRE_FALSE(std::ranges::bidirectional_range<zstring>);
+    STATIC_REQUIRE_FALSE(std::ranges::sized_range<zstring>);
+    STATIC_REQUIRE_FALSE(std::ranges::common_range<zstring>);
+  }
+
+  SECTION("cached begin") {
+    STATIC_REQUIRE(skip_zeros::caches_begin);
+    STATIC_REQUIRE_FALSE(int_span::caches_begin);
+    STATIC_REQUIRE(std::ranges::view<skip_zeros>);
+    STATIC_REQUIRE(std::ranges::contiguous_range<skip_zeros>);
+    STATIC_REQUIRE(std::ranges::sized_range<skip_zeros>);
+    STATIC_REQUIRE_FALSE(std::ranges::range<skip_zeros const>);
+  }
+}
+
+TEST_CASE("view_facade provides view_interface members", "[view]") {
+  constexpr static std::array values{1, 2, 3, 4, 5};
+  constexpr int_span view{values.data(), values.data() + values.size()};
+
+  STATIC_REQUIRE(view.size() == 5);
+  STATIC_REQUIRE(view.data() == values.data());
+  STATIC_REQUIRE(!view.empty());
+  STATIC_REQUIRE(view);
+  STATIC_REQUIRE(view.front() == 1);
+  STATIC_REQUIRE(view.back() == 5);
+  STATIC_REQUIRE(view[2] == 3);
+  STATIC_REQUIRE(int_span{values.data(), values.data()}.empty());
+
+  std::vector<int> copy(view.size());
+  std::ranges::copy(view, copy.begin());
+  REQUIRE(std::ranges::equal(copy, values));
+
+  constexpr zstring str{"hello"};
+  STATIC_REQUIRE(std::ranges::distance(str) == 5);
+  STATIC_REQUIRE(str.front() == 'h');
+  STATIC_REQUIRE(zstring{}.empty());
+}
+
+TEST_CASE("view_facade caches begin", "[view]") {
+  constexpr std::array values{0, 0, 0, 1, 2};
+  int calls = 0;
+  skip_zeros view{values.data(), values.data() + values.size(), &calls};
+
+  REQUIRE(calls == 0);
+  REQUIRE(view.front() == 1);
+  REQUIRE(view.size() == 2);
+  REQUIRE(std::ranges::equal(view, std::array{1, 2}));
+  REQUIRE(calls == 1);
+
+  // copies start with an empty cache
+  skip_zeros copy = view;
+  REQUIRE(*copy.begin() == 1);
+  REQUIRE(calls == 2);
+  REQUIRE(*view.begin() == 1);
+  REQUIRE(calls == 2);
+}
+
+}  // namespace iterator_facade
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <iterator_facade/zip_iterator.hpp>
+
+namespace iterator_facade {
+
+TEST_CASE("Zip iterator concepts", "[zip]") {
+  using iterator = zip_iterator<int*, std::string*>;
+  using reference = zip_reference<int&, std::string&>;
+
+  STATIC_REQUIRE(std::same_as<std::iter_reference_t<iterator>, reference>);
+  STATIC_REQUIRE(std::same_as<std::iter_value_t<iterator>, std::tuple<int, std::string>>);
+  STATIC_REQUIRE(std::same_as<std::iter_rvalue_reference_t<iterator>, std::tuple<int, std::string>>);
+  STATIC_REQUIRE(proxy_reference<reference>);
+  STATIC_REQUIRE(std::random_access_iterator<iterator>);
+  STATIC_REQUIRE(std::sortable<iterator>);
+  STATIC_REQUIRE(std::permutable<iterator>);
+  STATIC_REQUIRE(std::indirectly_writable<iterator, std::tuple<int, std::string>>);
+
+  STATIC_REQUIRE(std::bidirectional_iterator<zip_iterator<std::list<int>::iterator, int*>>);
+  STATIC_REQUIRE_FALSE(std::random_access_iterator<zip_iterator<std::list<int>::iterator, int*>>);
+  STATIC_REQUIRE(std::random_access_iterator<zip_iterator<int const*>>);
+
+  using pointers = zip_iterator<int*, int*>;
+  STATIC_REQUIRE(noexcept(std::ranges::iter_move(std::declval<pointers const&>())));
+  STATIC_REQUIRE(noexcept(std::ranges::iter_swap(std::declval<pointers const&>(), std::declval<pointers const&>())));
+  STATIC_REQUIRE(noexcept(std::ranges::iter_swap(std::declval<iterator const&>(), std::declval<iterator const&>())));
+  STATIC_REQUIRE(noexcept(std::declval<pointers const&>() == std::declval<pointers const&>()));
+  STATIC_REQUIRE(noexcept(std::declval<pointers const&>() - std::declval<pointers const&>()));
+  STATIC_REQUIRE(noexcept(std::declval<iterator const&>() < std::declval<iterator const&>()));
+}
+
+TEST_CASE("Zip iterator sorts structure of arrays in place", "[zip]") {
+  std::vector<int> keys{3, 1, 2, 1, 3};
+  std::vector<std::string> names{"c", "a", "b", "A", "C"};
+  std::array<double, 5> weights{0.3, 0.1, 0.2, 0.15, 0.35};
+  auto const soa = zip(keys, names, weights);
+
+  REQUIRE(std::ranges::size(soa) == 5);
+
+  SECTION("references") {
+    auto [key, name, weight] = *soa.begin();
+    STATIC_REQUIRE(std::same_as<decltype(get<0>(*soa.begin())), int&>);
+    REQUIRE(key == 3);
+    name.replace(0, name.size(), 1, 'z');
+    REQUIRE(names.front() == "z");
+
+    *(soa.begin() + 1) = std::tuple{7, std::string("x"), 0.7};
+    REQUIRE(keys[1] == 7);
+    REQUIRE(names[1] == "x");
+    REQUIRE(weights[1] == 0.7);
+
+    std::tuple<int, std::string, double> const value = soa.begin()[4];
+    REQUIRE(value == std::tuple{3, std::string("C"), 0.35});
+    REQUIRE(soa.begin()[4] == value);
+    REQUIRE(soa.begin()[1] > value);
+  }
+
+  SECTION("sort") {
+    std::ranges::sort(soa);
+    REQUIRE(keys == std::vector<int>{1, 1, 2, 3, 3});
+    REQUIRE(names == std::vector<std::string>{"A", "a", "b", "C", "c"});
+    REQUIRE(weights == std::array{0.15, 0.1, 0.2, 0.35, 0.3});
+  }
+
+  SECTION("stable_sort") {
+    std::ranges::stable_sort(soa, {}, [](auto const& element) -> int { return get<0>(element); });
+    REQUIRE(keys == std::vector<int>{1, 1, 2, 3, 3});
+    REQUIRE(names == std::vector<std::string>{"a", "A", "b", "c", "C"});
+    REQUIRE(weights == std::array{0.1, 0.15, 0.2, 0.3, 0.35});
+  }
+
+  SECTION("unique") {
+    std::ranges::sort(soa, {}, [](auto const& element) -> int { return get<0>(element); });
+    auto const key_equal = [](auto const& lhs, auto const& rhs) { return get<0>(lhs) == get<0>(rhs); };
+    auto const removed = std::ranges::unique(soa, key_equal);
+    auto const size = static_cast<std::size_t>(removed.begin() - soa.begin());
+    keys.resize(size);
+    REQUIRE(keys == std::vector<int>{1, 2, 3});
+    REQUIRE(names[1] == "b");
+  }
+
+  SECTION("iter_move and iter_swap") {
+    auto const first = soa.begin();
+    std::tuple<int, std::string, double> moved = std::ranges::iter_move(first);
+    REQUIRE(std::get<1>(moved) == "c");
+
+    std::ranges::iter_swap(first, first + 1);
+    REQUIRE(keys[0] == 1);
+    REQUIRE(names[0] == "a");
+    REQUIRE(keys[1] == 3);
+  }
+}
+
+TEST_CASE("Zip iterator ends with the shortest component", "[zip]") {
+  std::array<int, 3> short_range{1, 2, 3};
+  std::array<int, 5> long_range{5, 4, 3, 2, 1};
+
+  auto const zipped = zip(short_range, long_range);
+  REQUIRE(std::ranges::distance(zipped) == 3);
+
+  zip_iterator const first(short_range.begin(), long_range.begin());
+  zip_iterator const last(short_range.end(), long_range.end());
+  REQUIRE(last - first == 3);
+  REQUIRE(first - last == -3);
+  REQUIRE(std::ranges::distance(first, last) == 3);
+
+  // bidirectional zip iterators are only equal if all components are, the end has to be reached in lockstep
+  REQUIRE(first + 3 != last);
+  REQUIRE(first + 3 == zipped.end());
+  std::list<int> list{1, 2, 3, 4};
+  zip_iterator const list_first(list.begin(), long_range.begin());
+  zip_iterator const list_last(list.end(), long_range.begin() + 4);
+  REQUIRE(zip_iterator(list.end(), long_range.end()) != list_last);
+  int sum = 0;
+  for (auto it = list_first; it != list_last; ++it) sum += get<0>(*it) * get<1>(*it);
+  REQUIRE(sum == 5 + 8 + 9 + 8);
+  sum = 0;
+  for (auto it = list_last; it != list_first;) sum += get<0>(*--it);
+  REQUIRE(sum == 10);
+
+  // forward zip iterators end with the shortest component
+  std::forward_list<int> forward{1, 2};
+  zip_iterator const forward_first(forward.begin(), long_range.begin());
+  zip_iterator const forward_last(forward.end(), long_range.end());
+  REQUIRE(std::ranges::distance(forward_first, forward_last) == 2);
+}
+
+}  // namespace iterator_facade